@@ -0,0 +1,42 @@
+# Builds the ngu.obfuscxx module interface, the lean kernels and a consumer that imports the module,
+# then runs the consumer. Drives the compiler directly, so it works with CMake versions and generators
+# that have no C++20 module support (GCC -fmodules-ts, Clang --precompile).
+#
+# Required: CXX_COMPILER, CXX_COMPILER_ID, MODULE_SOURCE, KERNELS_SOURCE, SOURCE, INCLUDE_DIR, OUTPUT_DIR
+
+file(REMOVE_RECURSE ${OUTPUT_DIR})
+file(MAKE_DIRECTORY ${OUTPUT_DIR})
+
+function(run_step description)
+    execute_process(COMMAND ${ARGN} WORKING_DIRECTORY ${OUTPUT_DIR} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${description} failed")
+    endif()
+endfunction()
+
+set(flags -std=c++20 -O2 -I${INCLUDE_DIR})
+
+run_step("Compiling ${KERNELS_SOURCE}"
+    ${CXX_COMPILER} ${flags} -c ${KERNELS_SOURCE} -o kernels.o)
+
+if(CXX_COMPILER_ID STREQUAL "GNU")
+    # The compiled module interface lands in gcm.cache/ of the working directory
+    run_step("Compiling ${MODULE_SOURCE}"
+        ${CXX_COMPILER} ${flags} -fmodules-ts -x c++ -c ${MODULE_SOURCE} -o module.o)
+    run_step("Compiling ${SOURCE}"
+        ${CXX_COMPILER} ${flags} -fmodules-ts -c ${SOURCE} -o probe.o)
+elseif(CXX_COMPILER_ID MATCHES "Clang")
+    run_step("Precompiling ${MODULE_SOURCE}"
+        ${CXX_COMPILER} ${flags} -x c++-module --precompile ${MODULE_SOURCE} -o ngu.obfuscxx.pcm)
+    run_step("Compiling ngu.obfuscxx.pcm"
+        ${CXX_COMPILER} -O2 -c ngu.obfuscxx.pcm -o module.o)
+    run_step("Compiling ${SOURCE}"
+        ${CXX_COMPILER} ${flags} -fmodule-file=ngu.obfuscxx=ngu.obfuscxx.pcm -c ${SOURCE} -o probe.o)
+else()
+    message(FATAL_ERROR "check_module.cmake supports GCC and Clang, not ${CXX_COMPILER_ID}")
+endif()
+
+run_step("Linking the module probe"
+    ${CXX_COMPILER} probe.o module.o kernels.o -o module_probe)
+run_step("Running the module probe"
+    ${OUTPUT_DIR}/module_probe)
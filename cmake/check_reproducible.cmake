@@ -0,0 +1,32 @@
+# Compiles SOURCE twice with a fixed OBFUSCXX_SEED, at least one second apart so __TIME__
+# changes, and fails unless both objects are byte-identical.
+#
+# Required: CXX_COMPILER, CXX_COMPILER_ID, SOURCE, INCLUDE_DIR, OUTPUT_DIR
+
+file(MAKE_DIRECTORY ${OUTPUT_DIR})
+
+foreach(build first second)
+    set(object ${OUTPUT_DIR}/${build}.obj)
+
+    if(CXX_COMPILER_ID STREQUAL "MSVC")
+        set(args /nologo /std:c++20 /O2 /Brepro /constexpr:steps10000000
+            /DOBFUSCXX_SEED=0x5EED /I${INCLUDE_DIR} /c ${SOURCE} /Fo${object})
+    else()
+        set(args -std=c++20 -O2 -DOBFUSCXX_SEED=0x5EED -I${INCLUDE_DIR} -c ${SOURCE} -o ${object})
+    endif()
+
+    execute_process(COMMAND ${CXX_COMPILER} ${args} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Failed to compile ${SOURCE} (${build} build)")
+    endif()
+
+    if(build STREQUAL "first")
+        execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1.1)
+    endif()
+endforeach()
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files
+    ${OUTPUT_DIR}/first.obj ${OUTPUT_DIR}/second.obj RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Objects built with the same OBFUSCXX_SEED differ")
+endif()
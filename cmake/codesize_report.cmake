@@ -0,0 +1,78 @@
+# Compiles obfuscxx/metrics/codesize_probe.cpp for every (mode, level, type, size) combination and
+# writes the .text size and instruction count of each probe object to OUTPUT as JSON. Deltas are
+# relative to a baseline probe that does not use obfuscxx.
+#
+# Required: CXX_COMPILER, CXX_COMPILER_ID, CXX_COMPILER_VERSION, SIZE_TOOL, OBJDUMP_TOOL,
+#           SOURCE, INCLUDE_DIR, OUTPUT_DIR, OUTPUT
+
+set(modes inline outline)
+set(levels Low Medium High)
+set(types int float double char)
+set(sizes 1 16 256)
+set(flags -std=c++20 -O2 -DOBFUSCXX_SEED=0x5EED)
+
+file(MAKE_DIRECTORY ${OUTPUT_DIR})
+
+function(measure_probe name defines out_text out_instructions)
+    set(object ${OUTPUT_DIR}/${name}.o)
+
+    execute_process(COMMAND ${CXX_COMPILER} ${flags} ${defines} -I${INCLUDE_DIR} -c ${SOURCE} -o ${object}
+        RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Failed to compile probe ${name}")
+    endif()
+
+    # Sum every .text* section (inline code plus COMDAT template instantiations)
+    execute_process(COMMAND ${SIZE_TOOL} -A ${object} OUTPUT_VARIABLE sections)
+    string(REGEX MATCHALL "\n\\.text[^ \n]* +[0-9]+" text_sections "\n${sections}")
+    set(text 0)
+    foreach(section IN LISTS text_sections)
+        string(REGEX REPLACE ".* +([0-9]+)$" "\\1" bytes "${section}")
+        math(EXPR text "${text} + ${bytes}")
+    endforeach()
+
+    execute_process(COMMAND ${OBJDUMP_TOOL} -d --no-show-raw-insn ${object} OUTPUT_VARIABLE disassembly)
+    string(REGEX MATCHALL "\n +[0-9a-f]+:\t" instructions "${disassembly}")
+    list(LENGTH instructions instruction_count)
+
+    set(${out_text} ${text} PARENT_SCOPE)
+    set(${out_instructions} ${instruction_count} PARENT_SCOPE)
+endfunction()
+
+measure_probe(baseline "-DOBFUSCXX_PROBE_BASELINE" baseline_text baseline_instructions)
+
+set(probes "")
+foreach(mode IN LISTS modes)
+    foreach(level IN LISTS levels)
+        foreach(type IN LISTS types)
+            foreach(size IN LISTS sizes)
+                set(defines -DOBFUSCXX_PROBE_TYPE=${type} -DOBFUSCXX_PROBE_SIZE=${size} -DOBFUSCXX_PROBE_LEVEL=${level})
+                if(mode STREQUAL "outline")
+                    list(APPEND defines -DOBFUSCXX_OUTLINE_DECRYPT)
+                endif()
+
+                measure_probe(${mode}_${level}_${type}_${size} "${defines}" text instruction_count)
+                math(EXPR text_delta "${text} - ${baseline_text}")
+                math(EXPR instruction_delta "${instruction_count} - ${baseline_instructions}")
+
+                if(NOT probes STREQUAL "")
+                    string(APPEND probes ",\n")
+                endif()
+                string(APPEND probes "    { \"mode\": \"${mode}\", \"level\": \"${level}\", \"type\": \"${type}\", \"size\": ${size}, "
+                    "\"text_bytes\": ${text}, \"instructions\": ${instruction_count}, "
+                    "\"text_delta\": ${text_delta}, \"instructions_delta\": ${instruction_delta} }")
+            endforeach()
+        endforeach()
+    endforeach()
+endforeach()
+
+string(JOIN " " flags_string ${flags})
+file(WRITE ${OUTPUT} "{\n"
+    "  \"compiler\": \"${CXX_COMPILER_ID}\",\n"
+    "  \"compiler_version\": \"${CXX_COMPILER_VERSION}\",\n"
+    "  \"flags\": \"${flags_string}\",\n"
+    "  \"baseline\": { \"text_bytes\": ${baseline_text}, \"instructions\": ${baseline_instructions} },\n"
+    "  \"probes\": [\n${probes}\n  ]\n"
+    "}\n")
+
+message(STATUS "obfuscxx code size report: ${OUTPUT}")
@@ -0,0 +1,50 @@
+# obfuscxx_embed(<target> <file> [NAME <name>] [TYPE <type>] [LEVEL Low|Medium|High])
+#
+# Encrypts <file> at build time with the obfuscxx_embed tool and adds it to <target> as
+# ngu::embedded::<name>(), an ngu::embedded_asset<TYPE, LEVEL, ...>; include "<name>.h" to use it.
+# NAME defaults to the file name turned into an identifier, TYPE to unsigned char, LEVEL to Low.
+# OBFUSCXX_SEED, when set, makes the generated ciphertext reproducible. The ciphertext is linked as a
+# binary blob rather than compiled: through an .incbin stub with GCC and Clang, and as a COFF object
+# written by the tool with MSVC, so build time does not grow with the asset.
+function(obfuscxx_embed target file)
+    cmake_parse_arguments(EMBED "" "NAME;TYPE;LEVEL" "" ${ARGN})
+
+    get_filename_component(file ${file} ABSOLUTE)
+    if(NOT EMBED_NAME)
+        get_filename_component(EMBED_NAME ${file} NAME)
+        string(MAKE_C_IDENTIFIER ${EMBED_NAME} EMBED_NAME)
+    endif()
+    if(NOT EMBED_TYPE)
+        set(EMBED_TYPE "unsigned char")
+    endif()
+    if(NOT EMBED_LEVEL)
+        set(EMBED_LEVEL Low)
+    endif()
+
+    set(output_dir ${CMAKE_CURRENT_BINARY_DIR}/obfuscxx_embed/${target})
+    file(MAKE_DIRECTORY ${output_dir})
+
+    set(args --type ${EMBED_TYPE} --level ${EMBED_LEVEL})
+    if(NOT OBFUSCXX_SEED STREQUAL "")
+        list(APPEND args --seed ${OBFUSCXX_SEED})
+    endif()
+
+    if(MSVC)
+        list(APPEND args --coff ${CMAKE_CXX_COMPILER_ARCHITECTURE_ID})
+        set(outputs ${output_dir}/${EMBED_NAME}.obj)
+    else()
+        set(outputs ${output_dir}/${EMBED_NAME}.bin ${output_dir}/${EMBED_NAME}.cpp)
+    endif()
+
+    add_custom_command(
+        OUTPUT ${output_dir}/${EMBED_NAME}.h ${outputs}
+        COMMAND obfuscxx_embed ${file} ${output_dir} ${EMBED_NAME} ${args}
+        DEPENDS obfuscxx_embed ${file}
+        COMMENT "Encrypting ${file}"
+        VERBATIM
+    )
+
+    target_sources(${target} PRIVATE ${output_dir}/${EMBED_NAME}.h ${outputs})
+    target_include_directories(${target} PRIVATE ${output_dir})
+    target_link_libraries(${target} PRIVATE obfuscxx)
+endfunction()
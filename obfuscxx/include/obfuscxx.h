@@ -5,6 +5,7 @@
 #ifndef NGU_OBFUSCXX_H
 #define NGU_OBFUSCXX_H
 
+#include <bit>
 #include <cstdint>
 #include <initializer_list>
 
@@ -15,7 +16,23 @@ using max_align_t = double;
 
 #include <type_traits>
 
-#if defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#if !defined(_KERNEL_MODE) && !defined(_WIN64_DRIVER)
+#include <iosfwd>
+#include <span>
+#include <tuple>
+#endif
+
+// OBFUSCXX_LEAN keeps the intrinsic headers out of the including translation unit, decryption runs in
+// the kernels of src/obfuscxx_kernels.cpp
+#if defined(OBFUSCXX_LEAN)
+#if defined(_KERNEL_MODE) || defined(_WIN64_DRIVER)
+#error OBFUSCXX_LEAN is not available in kernel mode
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+extern "C" void _ReadWriteBarrier(void);
+#pragma intrinsic(_ReadWriteBarrier)
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
 #include <arm_neon.h>
 #elif defined(_MSC_VER) || defined(__clang__)
 #include <intrin.h>
@@ -38,8 +55,12 @@ using max_align_t = double;
 #define OBFUSCXX_FORCEINLINE __forceinline
 #endif
 
-#if defined(_KERNEL_MODE) || defined(_WIN64_DRIVER)
-#define _mm256_extract_epi32(vec, idx) (((int32_t*)&(vec))[(idx)])
+#if defined(__clang__)
+#define OBFUSCXX_NOINLINE __attribute__((noinline))
+#elif defined(__GNUC__)
+#define OBFUSCXX_NOINLINE __attribute__((noinline, noclone))
+#else
+#define OBFUSCXX_NOINLINE __declspec(noinline)
 #endif
 
 #if defined(__clang__) || defined(__GNUC__)
@@ -50,11 +71,15 @@ using max_align_t = double;
 
 #ifndef OBFUSCXX_DISABLE_WARNS
 #define OBFUSCXX_RUNTIME_WARNING [[deprecated("OBFUSCXX: Runtime set() uses encrypt method without SIMD obfuscation. For better protection, initialize at compile-time.")]]
+#define OBFUSCXX_RUNTIME_BULK_WARNING [[deprecated("OBFUSCXX: set_range()/assign() encrypt at runtime, so the plaintext values exist in memory before encryption. For better protection, initialize at compile-time.")]]
 #else
 #define OBFUSCXX_RUNTIME_WARNING
+#define OBFUSCXX_RUNTIME_BULK_WARNING
 #endif
 
 namespace ngu {
+    enum class obf_level : std::uint8_t { Low, Medium, High };
+
     namespace detail {
         constexpr std::uint64_t splitmix64(std::uint64_t x) {
             x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
@@ -78,7 +103,7 @@ namespace ngu {
             return hash;
         }
 
-        OBFUSCXX_FORCEINLINE std::uint64_t hash_runtime(char const *str) {
+        OBFUSCXX_FORCEINLINE constexpr std::uint64_t hash_runtime(char const *str) {
             std::size_t length = 0;
             while (str[length])
                 ++length;
@@ -109,11 +134,781 @@ namespace ngu {
             if (n == 0) return x;
             return (x >> n) | (x << (64 - n));
         }
+
+        // Per-instance XTEA round keys in encryption order: keys[2 * i] feeds the v0 half-round and
+        // keys[2 * i + 1] the v1 half-round of round i
+        template<std::uint32_t Rounds> struct xtea_schedule {
+            std::uint32_t keys[Rounds * 2];
+        };
+
+        // Key material derived from a per-site seed, shared by obfuscxx and the build-time tools
+        struct xtea_key {
+            std::uint64_t iv[8];
+            std::uint32_t rounds;
+            std::uint32_t delta;
+        };
+
+        inline constexpr std::uint32_t xtea_max_rounds = 20;
+
+        constexpr xtea_key make_xtea_key(std::uint64_t seed, obf_level level) {
+            xtea_key key{ {
+                0xcbf43b227a01fe5aULL ^ seed,
+                0x32703be7aaa7c38fULL ^ ror64(seed, 13),
+                0xb589959b3d854bbcULL ^ rol64(seed, 29),
+                0x73b3ef5578a97c8aULL ^ ror64(seed, 41),
+                0x92afafd27c6e16e9ULL ^ rol64(seed, 7),
+                0xee8291ae3070720aULL ^ ror64(seed, 53),
+                0xe2c0d70f73d6c4a0ULL ^ rol64(seed, 19),
+                0x82742897b912855bULL ^ ror64(seed, 37),
+            }, 0, 0 };
+
+            const std::uint64_t unique_index = seed & 7;
+            const std::uint64_t unique_value = key.iv[unique_index];
+
+            key.rounds = (level == obf_level::Low) ? 2 : (level == obf_level::Medium) ? 6 : (6 + ((unique_index & 0x7) * 2));
+            key.delta = (0x9E3779B9 ^ static_cast<std::uint32_t>(unique_value)) | 1;
+
+            return key;
+        }
+
+        // Scalar <-> 64-bit block conversions shared by every container
+        template<class Type> constexpr std::uint64_t to_block(Type value) {
+            if constexpr (std::is_pointer_v<Type>) {
+                return reinterpret_cast<std::uint64_t>(value);
+            } else if constexpr (std::is_floating_point_v<Type>) {
+                if constexpr (sizeof(Type) == 4) {
+                    return __builtin_bit_cast(std::uint32_t, value);
+                } else {
+                    return __builtin_bit_cast(std::uint64_t, value);
+                }
+            } else {
+                return static_cast<std::uint64_t>(value);
+            }
+        }
+
+        template<class Type> OBFUSCXX_FORCEINLINE Type from_block(std::uint64_t value) {
+            if constexpr (std::is_pointer_v<Type>) {
+                return reinterpret_cast<Type>(value);
+            } else if constexpr (std::is_floating_point_v<Type>) {
+                if constexpr (sizeof(Type) == 4) {
+                    return __builtin_bit_cast(Type, static_cast<std::uint32_t>(value));
+                } else {
+                    return __builtin_bit_cast(Type, value);
+                }
+            } else {
+                return static_cast<Type>(value);
+            }
+        }
+
+        constexpr void fill_xtea_keys(const std::uint64_t *iv, std::uint32_t delta, std::uint32_t rounds, std::uint32_t *keys) {
+            std::uint32_t sum = 0;
+
+            for (std::uint32_t i = 0; i < rounds; ++i) {
+                keys[i * 2] = sum + static_cast<std::uint32_t>(iv[sum & 3]);
+                sum += delta;
+                keys[i * 2 + 1] = sum + static_cast<std::uint32_t>(iv[(sum >> 11) & 3]);
+            }
+        }
+
+        // Clears plaintext scratch of the runtime containers in a way dead-store elimination cannot drop
+        inline void wipe(void *p, std::size_t bytes) {
+            auto *b = static_cast<unsigned char*>(p);
+            for (std::size_t i = 0; i < bytes; ++i) b[i] = 0;
+            OBFUSCXX_MEM_BARRIER(p)
+        }
+
+        template<std::uint32_t Rounds> consteval xtea_schedule<Rounds> make_xtea_schedule(const std::uint64_t (&iv)[8], std::uint32_t delta) {
+            xtea_schedule<Rounds> schedule{};
+            fill_xtea_keys(iv, delta, Rounds, schedule.keys);
+            return schedule;
+        }
+
+        // Kernels for OBFUSCXX_LEAN translation units, defined once in src/obfuscxx_kernels.cpp (the
+        // obfuscxx_lean library). C linkage keeps the symbols the same whether they are reached from a
+        // header or from the ngu.obfuscxx module
+        extern "C" std::uint64_t ngu_obfuscxx_decrypt(std::uint64_t value, const std::uint32_t *keys, std::uint32_t rounds);
+        extern "C" void ngu_obfuscxx_decrypt_blocks(const std::uint64_t *in, std::uint64_t *out, std::size_t count, const std::uint32_t *keys, std::uint32_t rounds);
+        extern "C" void ngu_obfuscxx_encrypt_blocks(const std::uint64_t *in, std::uint64_t *out, std::size_t count, const std::uint32_t *keys, std::uint32_t rounds);
+        extern "C" std::size_t ngu_obfuscxx_find_u64(const std::uint64_t *data, std::size_t size, std::uint64_t needle);
+        extern "C" std::size_t ngu_obfuscxx_count_u64(const std::uint64_t *data, std::size_t size, std::uint64_t needle);
+
+        // Shared decrypt kernel for OBFUSCXX_OUTLINE_DECRYPT: one out-of-line copy per ISA and round count,
+        // the per-instance constants stay in the constexpr key table passed by the call site
+#if defined(OBFUSCXX_LEAN)
+        inline namespace lean {
+            template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE std::uint64_t xtea_decrypt_outlined(std::uint64_t value, const std::uint32_t *keys) {
+                return ngu_obfuscxx_decrypt(value, keys, Rounds);
+            }
+        }
+#else
+        template<std::uint32_t Rounds> OBFUSCXX_NOINLINE std::uint64_t xtea_decrypt_outlined(std::uint64_t value, const std::uint32_t *keys) {
+            OBFUSCXX_MEM_BARRIER(value)
+            OBFUSCXX_MEM_BARRIER(keys)
+
+            std::uint32_t v0 = static_cast<std::uint32_t>(value);
+            std::uint32_t v1 = static_cast<std::uint32_t>(value >> 32);
+
+            for (std::uint32_t i = Rounds; i-- > 0;) {
+                OBFUSCXX_MEM_BARRIER(v0)
+                OBFUSCXX_MEM_BARRIER(v1)
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+                // ARM64 - NEON
+                uint32x4_t neon_v0 = vdupq_n_u32(v0);
+                uint32x4_t neon_temp = vaddq_u32(veorq_u32(vshlq_n_u32(neon_v0, 4), vshrq_n_u32(neon_v0, 5)), neon_v0);
+                neon_temp = veorq_u32(neon_temp, vdupq_n_u32(keys[i * 2 + 1]));
+                v1 = vgetq_lane_u32(vsubq_u32(vdupq_n_u32(v1), neon_temp), 0);
+
+                OBFUSCXX_MEM_BARRIER(v0)
+                OBFUSCXX_MEM_BARRIER(v1)
+
+                uint32x4_t neon_v1 = vdupq_n_u32(v1);
+                neon_temp = vaddq_u32(veorq_u32(vshlq_n_u32(neon_v1, 4), vshrq_n_u32(neon_v1, 5)), neon_v1);
+                neon_temp = veorq_u32(neon_temp, vdupq_n_u32(keys[i * 2]));
+                v0 = vgetq_lane_u32(vsubq_u32(vdupq_n_u32(v0), neon_temp), 0);
+#else
+                // x86/x64 - SSE2
+                __m128i xmm_v0 = _mm_cvtsi32_si128(static_cast<int>(v0));
+                __m128i xmm_temp = _mm_add_epi32(_mm_xor_si128(_mm_slli_epi32(xmm_v0, 4), _mm_srli_epi32(xmm_v0, 5)), xmm_v0);
+                xmm_temp = _mm_xor_si128(xmm_temp, _mm_cvtsi32_si128(static_cast<int>(keys[i * 2 + 1])));
+                v1 = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_sub_epi32(_mm_cvtsi32_si128(static_cast<int>(v1)), xmm_temp)));
+
+                OBFUSCXX_MEM_BARRIER(v0)
+                OBFUSCXX_MEM_BARRIER(v1)
+
+                __m128i xmm_v1 = _mm_cvtsi32_si128(static_cast<int>(v1));
+                xmm_temp = _mm_add_epi32(_mm_xor_si128(_mm_slli_epi32(xmm_v1, 4), _mm_srli_epi32(xmm_v1, 5)), xmm_v1);
+                xmm_temp = _mm_xor_si128(xmm_temp, _mm_cvtsi32_si128(static_cast<int>(keys[i * 2])));
+                v0 = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_sub_epi32(_mm_cvtsi32_si128(static_cast<int>(v0)), xmm_temp)));
+#endif
+            }
+
+            return (static_cast<std::uint64_t>(v1) << 32) | v0;
+        }
+#endif
+
+        // Scalar reference XTEA on one 64-bit block with a precomputed key schedule
+        constexpr std::uint64_t xtea_encrypt_block(std::uint64_t value, const std::uint32_t *keys, std::uint32_t rounds) {
+            std::uint32_t v0 = static_cast<std::uint32_t>(value);
+            std::uint32_t v1 = static_cast<std::uint32_t>(value >> 32);
+
+            for (std::uint32_t i = 0; i < rounds; ++i) {
+                v0 += (((v1 << 4) ^ (v1 >> 5)) + v1) ^ keys[i * 2];
+                v1 += (((v0 << 4) ^ (v0 >> 5)) + v0) ^ keys[i * 2 + 1];
+            }
+
+            return (static_cast<std::uint64_t>(v1) << 32) | v0;
+        }
+
+        constexpr std::uint64_t xtea_decrypt_block(std::uint64_t value, const std::uint32_t *keys, std::uint32_t rounds) {
+            std::uint32_t v0 = static_cast<std::uint32_t>(value);
+            std::uint32_t v1 = static_cast<std::uint32_t>(value >> 32);
+
+            for (std::uint32_t i = rounds; i-- > 0;) {
+                v1 -= (((v0 << 4) ^ (v0 >> 5)) + v0) ^ keys[i * 2 + 1];
+                v0 -= (((v1 << 4) ^ (v1 >> 5)) + v1) ^ keys[i * 2];
+            }
+
+            return (static_cast<std::uint64_t>(v1) << 32) | v0;
+        }
+
+        // Portable multi-lane kernel: one round function written against a thin lane wrapper (GCC/Clang
+        // vector extensions, plain lane arrays elsewhere) and instantiable at any width. The hand-tuned
+        // xtea_decrypt_blocks/xtea_encrypt_blocks kernels remain the default; OBFUSCXX_GENERIC_SIMD
+        // routes them through this kernel at the native width
+        namespace simd {
+#if defined(__AVX512F__)
+            inline constexpr std::size_t native_lanes = 16;
+#elif defined(__AVX2__)
+            inline constexpr std::size_t native_lanes = 8;
+#else
+            inline constexpr std::size_t native_lanes = 4;
+#endif
+
+#if defined(__clang__) || defined(__GNUC__)
+            template<std::size_t Lanes> struct lanes {
+                typedef std::uint32_t u32 __attribute__((vector_size(Lanes * 4)));
+                typedef std::uint64_t u64 __attribute__((vector_size(Lanes * 8)));
+            };
+
+            template<std::size_t Lanes> OBFUSCXX_FORCEINLINE void load(const std::uint64_t *in, typename lanes<Lanes>::u32 &v0, typename lanes<Lanes>::u32 &v1) {
+                typename lanes<Lanes>::u64 block;
+                __builtin_memcpy(&block, in, sizeof(block));
+                v0 = __builtin_convertvector(block, typename lanes<Lanes>::u32);
+                v1 = __builtin_convertvector(block >> 32, typename lanes<Lanes>::u32);
+            }
+
+            template<std::size_t Lanes> OBFUSCXX_FORCEINLINE void store(std::uint64_t *out, const typename lanes<Lanes>::u32 &v0, const typename lanes<Lanes>::u32 &v1) {
+                const typename lanes<Lanes>::u64 block =
+                    __builtin_convertvector(v0, typename lanes<Lanes>::u64) | (__builtin_convertvector(v1, typename lanes<Lanes>::u64) << 32);
+                __builtin_memcpy(out, &block, sizeof(block));
+            }
+#else
+            template<std::size_t Lanes> struct lanes {
+                struct u32 {
+                    std::uint32_t lane[Lanes];
+
+#define OBFUSCXX_LANE_OP(op) \
+                    friend OBFUSCXX_FORCEINLINE u32 operator op(u32 a, u32 b) { for (std::size_t l = 0; l < Lanes; ++l) a.lane[l] = a.lane[l] op b.lane[l]; return a; } \
+                    friend OBFUSCXX_FORCEINLINE u32 operator op(u32 a, std::uint32_t b) { for (std::size_t l = 0; l < Lanes; ++l) a.lane[l] = a.lane[l] op b; return a; } \
+                    OBFUSCXX_FORCEINLINE u32 &operator op##=(u32 b) { return *this = *this op b; }
+                    OBFUSCXX_LANE_OP(+)
+                    OBFUSCXX_LANE_OP(-)
+                    OBFUSCXX_LANE_OP(^)
+                    OBFUSCXX_LANE_OP(<<)
+                    OBFUSCXX_LANE_OP(>>)
+#undef OBFUSCXX_LANE_OP
+                };
+
+            };
+
+            template<std::size_t Lanes> OBFUSCXX_FORCEINLINE void load(const std::uint64_t *in, typename lanes<Lanes>::u32 &v0, typename lanes<Lanes>::u32 &v1) {
+                for (std::size_t l = 0; l < Lanes; ++l) {
+                    v0.lane[l] = static_cast<std::uint32_t>(in[l]);
+                    v1.lane[l] = static_cast<std::uint32_t>(in[l] >> 32);
+                }
+            }
+
+            template<std::size_t Lanes> OBFUSCXX_FORCEINLINE void store(std::uint64_t *out, const typename lanes<Lanes>::u32 &v0, const typename lanes<Lanes>::u32 &v1) {
+                for (std::size_t l = 0; l < Lanes; ++l) {
+                    out[l] = (static_cast<std::uint64_t>(v1.lane[l]) << 32) | v0.lane[l];
+                }
+            }
+#endif
+
+            template<std::size_t Lanes, std::uint32_t Rounds, bool Encrypt>
+            OBFUSCXX_FORCEINLINE void xtea_blocks(const std::uint64_t *in, std::uint64_t *out, std::size_t count, const std::uint32_t *keys) {
+                static_assert(Lanes >= 2 && (Lanes & (Lanes - 1)) == 0, "lane count must be a power of two, at least 2");
+
+                using u32 = typename lanes<Lanes>::u32;
+                const std::size_t whole = count / Lanes * Lanes;
+                std::size_t i = 0;
+
+                for (; i < whole; i += Lanes) {
+                    u32 v0, v1;
+                    load<Lanes>(in + i, v0, v1);
+
+                    if constexpr (Encrypt) {
+                        for (std::uint32_t r = 0; r < Rounds; ++r) {
+                            v0 += (((v1 << 4) ^ (v1 >> 5)) + v1) ^ keys[r * 2];
+                            v1 += (((v0 << 4) ^ (v0 >> 5)) + v0) ^ keys[r * 2 + 1];
+                        }
+                    } else {
+                        for (std::uint32_t r = Rounds; r-- > 0;) {
+                            v1 -= (((v0 << 4) ^ (v0 >> 5)) + v0) ^ keys[r * 2 + 1];
+                            v0 -= (((v1 << 4) ^ (v1 >> 5)) + v1) ^ keys[r * 2];
+                        }
+                    }
+
+                    store<Lanes>(out + i, v0, v1);
+                }
+
+                for (; i < count; ++i) {
+                    out[i] = Encrypt ? xtea_encrypt_block(in[i], keys, Rounds) : xtea_decrypt_block(in[i], keys, Rounds);
+                }
+            }
+        }
+
+        // Per-lane key schedules for decrypting unrelated instances side by side. Lane l runs its own
+        // rounds; for rounds it does not have the mask is zero and the lane is left untouched
+        template<std::size_t Lanes> struct lane_schedule {
+            std::uint32_t keys[xtea_max_rounds][2][Lanes];
+            std::uint32_t masks[xtea_max_rounds][Lanes];
+        };
+
+        // Padding bytes are never initialized in a constant expression, so the consteval constructor
+        // cannot bit_cast an object that has any. Probed by bit-casting a value-initialized Type: the
+        // template argument is not a constant for padded types and the requirement fails
+        template<class Type> consteval bool object_bytes_readable() {
+            struct raw { unsigned char bytes[sizeof(Type)]; };
+            const raw value = std::bit_cast<raw>(Type{});
+            unsigned sum = 0;
+            for (unsigned char b : value.bytes) sum += b;
+            return sum == 0;
+        }
+
+        // Types that cannot be value-initialized cannot be probed and need unique object representations
+        // instead; that also rejects floating-point members, which have several representations
+        template<class Type> concept padding_free =
+            (std::is_default_constructible_v<Type> && requires { typename std::bool_constant<object_bytes_readable<Type>()>; }) ||
+            (!std::is_default_constructible_v<Type> && std::has_unique_object_representations_v<Type>);
+
+        // Grants obfuscxx_pack, obf_concat and the companion containers access to the ciphertext and key
+        // schedule of instances
+        struct instance_access;
+
+        // Byte offset of a data member; Itanium and MSVC both represent pointers to data members of
+        // non-virtual classes as the plain offset. With base classes the pointer is relative to the
+        // base that declares the member, hence standard layout only
+        template<class Class, class Field> OBFUSCXX_FORCEINLINE std::size_t member_offset(Field Class::*member) {
+            static_assert(std::is_standard_layout_v<Class>, "obfuscxx: get<&T::field>() needs a standard-layout T");
+            if constexpr (sizeof(member) == sizeof(std::uint32_t)) {
+                return std::bit_cast<std::uint32_t>(member);
+            } else {
+                return static_cast<std::size_t>(std::bit_cast<std::uint64_t>(member));
+            }
+        }
+
+#if !defined(OBFUSCXX_LEAN)
+        // Decrypt rounds on deinterleaved halves, one overload per register type; shared by the bulk
+        // kernels and the register loaders
+#if defined(__aarch64__) || defined(_M_ARM64)
+        template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE void xtea_decrypt_rounds(uint32x4_t &neon_v0, uint32x4_t &neon_v1, const std::uint32_t *keys) {
+            for (std::uint32_t r = Rounds; r-- > 0;) {
+                uint32x4_t neon_temp = vaddq_u32(veorq_u32(vshlq_n_u32(neon_v0, 4), vshrq_n_u32(neon_v0, 5)), neon_v0);
+                neon_v1 = vsubq_u32(neon_v1, veorq_u32(neon_temp, vdupq_n_u32(keys[r * 2 + 1])));
+                neon_temp = vaddq_u32(veorq_u32(vshlq_n_u32(neon_v1, 4), vshrq_n_u32(neon_v1, 5)), neon_v1);
+                neon_v0 = vsubq_u32(neon_v0, veorq_u32(neon_temp, vdupq_n_u32(keys[r * 2])));
+            }
+        }
+#else
+#if defined(__AVX512F__)
+        template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE void xtea_decrypt_rounds(__m512i &zmm_v0, __m512i &zmm_v1, const std::uint32_t *keys) {
+            for (std::uint32_t r = Rounds; r-- > 0;) {
+                __m512i zmm_temp = _mm512_add_epi32(_mm512_xor_si512(_mm512_slli_epi32(zmm_v0, 4), _mm512_srli_epi32(zmm_v0, 5)), zmm_v0);
+                zmm_v1 = _mm512_sub_epi32(zmm_v1, _mm512_xor_si512(zmm_temp, _mm512_set1_epi32(static_cast<int>(keys[r * 2 + 1]))));
+                zmm_temp = _mm512_add_epi32(_mm512_xor_si512(_mm512_slli_epi32(zmm_v1, 4), _mm512_srli_epi32(zmm_v1, 5)), zmm_v1);
+                zmm_v0 = _mm512_sub_epi32(zmm_v0, _mm512_xor_si512(zmm_temp, _mm512_set1_epi32(static_cast<int>(keys[r * 2]))));
+            }
+        }
+#endif
+#if defined(__AVX2__)
+        template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE void xtea_decrypt_rounds(__m256i &ymm_v0, __m256i &ymm_v1, const std::uint32_t *keys) {
+            for (std::uint32_t r = Rounds; r-- > 0;) {
+                __m256i ymm_temp = _mm256_add_epi32(_mm256_xor_si256(_mm256_slli_epi32(ymm_v0, 4), _mm256_srli_epi32(ymm_v0, 5)), ymm_v0);
+                ymm_v1 = _mm256_sub_epi32(ymm_v1, _mm256_xor_si256(ymm_temp, _mm256_set1_epi32(static_cast<int>(keys[r * 2 + 1]))));
+                ymm_temp = _mm256_add_epi32(_mm256_xor_si256(_mm256_slli_epi32(ymm_v1, 4), _mm256_srli_epi32(ymm_v1, 5)), ymm_v1);
+                ymm_v0 = _mm256_sub_epi32(ymm_v0, _mm256_xor_si256(ymm_temp, _mm256_set1_epi32(static_cast<int>(keys[r * 2]))));
+            }
+        }
+#endif
+        template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE void xtea_decrypt_rounds(__m128i &xmm_v0, __m128i &xmm_v1, const std::uint32_t *keys) {
+            for (std::uint32_t r = Rounds; r-- > 0;) {
+                __m128i xmm_temp = _mm_add_epi32(_mm_xor_si128(_mm_slli_epi32(xmm_v0, 4), _mm_srli_epi32(xmm_v0, 5)), xmm_v0);
+                xmm_v1 = _mm_sub_epi32(xmm_v1, _mm_xor_si128(xmm_temp, _mm_set1_epi32(static_cast<int>(keys[r * 2 + 1]))));
+                xmm_temp = _mm_add_epi32(_mm_xor_si128(_mm_slli_epi32(xmm_v1, 4), _mm_srli_epi32(xmm_v1, 5)), xmm_v1);
+                xmm_v0 = _mm_sub_epi32(xmm_v0, _mm_xor_si128(xmm_temp, _mm_set1_epi32(static_cast<int>(keys[r * 2]))));
+            }
+        }
+#endif
+
+        // Multi-lane decrypt of count blocks sharing one key schedule: every SIMD lane holds one block,
+        // v0/v1 halves are deinterleaved on load and interleaved back on store
+        template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE void xtea_decrypt_blocks(const std::uint64_t *in, std::uint64_t *out, std::size_t count, const std::uint32_t *keys) {
+#if defined(OBFUSCXX_GENERIC_SIMD)
+            simd::xtea_blocks<simd::native_lanes, Rounds, false>(in, out, count, keys);
+#else
+            std::size_t i = 0;
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+            // ARM64 - NEON, 4 blocks per pass
+            for (; count - i >= 4; i += 4) {
+                uint32x4x2_t neon_block = vld2q_u32(reinterpret_cast<const std::uint32_t*>(in + i));
+                uint32x4_t neon_v0 = neon_block.val[0];
+                uint32x4_t neon_v1 = neon_block.val[1];
+
+                xtea_decrypt_rounds<Rounds>(neon_v0, neon_v1, keys);
+
+                neon_block.val[0] = neon_v0;
+                neon_block.val[1] = neon_v1;
+                vst2q_u32(reinterpret_cast<std::uint32_t*>(out + i), neon_block);
+            }
+#else
+#if defined(__AVX512F__)
+            // x64 - AVX-512, 16 blocks per pass
+            for (; count - i >= 16; i += 16) {
+                __m512 zmm_a = _mm512_castsi512_ps(_mm512_loadu_si512(in + i));
+                __m512 zmm_b = _mm512_castsi512_ps(_mm512_loadu_si512(in + i + 8));
+                __m512i zmm_v0 = _mm512_castps_si512(_mm512_shuffle_ps(zmm_a, zmm_b, _MM_SHUFFLE(2, 0, 2, 0)));
+                __m512i zmm_v1 = _mm512_castps_si512(_mm512_shuffle_ps(zmm_a, zmm_b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+                xtea_decrypt_rounds<Rounds>(zmm_v0, zmm_v1, keys);
+
+                _mm512_storeu_si512(out + i, _mm512_unpacklo_epi32(zmm_v0, zmm_v1));
+                _mm512_storeu_si512(out + i + 8, _mm512_unpackhi_epi32(zmm_v0, zmm_v1));
+            }
+#endif
+#if defined(__AVX2__)
+            // x64 - AVX2, 8 blocks per pass
+            for (; count - i >= 8; i += 8) {
+                __m256 ymm_a = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+                __m256 ymm_b = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 4)));
+                __m256i ymm_v0 = _mm256_castps_si256(_mm256_shuffle_ps(ymm_a, ymm_b, _MM_SHUFFLE(2, 0, 2, 0)));
+                __m256i ymm_v1 = _mm256_castps_si256(_mm256_shuffle_ps(ymm_a, ymm_b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+                xtea_decrypt_rounds<Rounds>(ymm_v0, ymm_v1, keys);
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_unpacklo_epi32(ymm_v0, ymm_v1));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 4), _mm256_unpackhi_epi32(ymm_v0, ymm_v1));
+            }
+#endif
+            // x86/x64 - SSE2, 4 blocks per pass
+            for (; count - i >= 4; i += 4) {
+                __m128 xmm_a = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+                __m128 xmm_b = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 2)));
+                __m128i xmm_v0 = _mm_castps_si128(_mm_shuffle_ps(xmm_a, xmm_b, _MM_SHUFFLE(2, 0, 2, 0)));
+                __m128i xmm_v1 = _mm_castps_si128(_mm_shuffle_ps(xmm_a, xmm_b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+                xtea_decrypt_rounds<Rounds>(xmm_v0, xmm_v1, keys);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi32(xmm_v0, xmm_v1));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 2), _mm_unpackhi_epi32(xmm_v0, xmm_v1));
+            }
+#endif
+
+            for (; i < count; ++i) {
+                out[i] = xtea_decrypt_block(in[i], keys, Rounds);
+            }
+#endif
+        }
+
+        // Bulk counterpart of xtea_decrypt_outlined for OBFUSCXX_OUTLINE_DECRYPT: copy_to, to_string and
+        // object reads share one out-of-line multi-lane loop per round count
+        template<std::uint32_t Rounds> OBFUSCXX_NOINLINE void xtea_decrypt_blocks_outlined(const std::uint64_t *in, std::uint64_t *out, std::size_t count, const std::uint32_t *keys) {
+            OBFUSCXX_MEM_BARRIER(in)
+            OBFUSCXX_MEM_BARRIER(keys)
+            xtea_decrypt_blocks<Rounds>(in, out, count, keys);
+        }
+
+        // Multi-lane encrypt producing exactly the ciphertext of xtea_encrypt_block, same lane layout as
+        // xtea_decrypt_blocks
+        template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE void xtea_encrypt_blocks(const std::uint64_t *in, std::uint64_t *out, std::size_t count, const std::uint32_t *keys) {
+#if defined(OBFUSCXX_GENERIC_SIMD)
+            simd::xtea_blocks<simd::native_lanes, Rounds, true>(in, out, count, keys);
+#else
+            std::size_t i = 0;
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+            // ARM64 - NEON, 4 blocks per pass
+            for (; count - i >= 4; i += 4) {
+                uint32x4x2_t neon_block = vld2q_u32(reinterpret_cast<const std::uint32_t*>(in + i));
+                uint32x4_t neon_v0 = neon_block.val[0];
+                uint32x4_t neon_v1 = neon_block.val[1];
+
+                for (std::uint32_t r = 0; r < Rounds; ++r) {
+                    uint32x4_t neon_temp = vaddq_u32(veorq_u32(vshlq_n_u32(neon_v1, 4), vshrq_n_u32(neon_v1, 5)), neon_v1);
+                    neon_v0 = vaddq_u32(neon_v0, veorq_u32(neon_temp, vdupq_n_u32(keys[r * 2])));
+                    neon_temp = vaddq_u32(veorq_u32(vshlq_n_u32(neon_v0, 4), vshrq_n_u32(neon_v0, 5)), neon_v0);
+                    neon_v1 = vaddq_u32(neon_v1, veorq_u32(neon_temp, vdupq_n_u32(keys[r * 2 + 1])));
+                }
+
+                neon_block.val[0] = neon_v0;
+                neon_block.val[1] = neon_v1;
+                vst2q_u32(reinterpret_cast<std::uint32_t*>(out + i), neon_block);
+            }
+#else
+#if defined(__AVX512F__)
+            // x64 - AVX-512, 16 blocks per pass
+            for (; count - i >= 16; i += 16) {
+                __m512 zmm_a = _mm512_castsi512_ps(_mm512_loadu_si512(in + i));
+                __m512 zmm_b = _mm512_castsi512_ps(_mm512_loadu_si512(in + i + 8));
+                __m512i zmm_v0 = _mm512_castps_si512(_mm512_shuffle_ps(zmm_a, zmm_b, _MM_SHUFFLE(2, 0, 2, 0)));
+                __m512i zmm_v1 = _mm512_castps_si512(_mm512_shuffle_ps(zmm_a, zmm_b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+                for (std::uint32_t r = 0; r < Rounds; ++r) {
+                    __m512i zmm_temp = _mm512_add_epi32(_mm512_xor_si512(_mm512_slli_epi32(zmm_v1, 4), _mm512_srli_epi32(zmm_v1, 5)), zmm_v1);
+                    zmm_v0 = _mm512_add_epi32(zmm_v0, _mm512_xor_si512(zmm_temp, _mm512_set1_epi32(static_cast<int>(keys[r * 2]))));
+                    zmm_temp = _mm512_add_epi32(_mm512_xor_si512(_mm512_slli_epi32(zmm_v0, 4), _mm512_srli_epi32(zmm_v0, 5)), zmm_v0);
+                    zmm_v1 = _mm512_add_epi32(zmm_v1, _mm512_xor_si512(zmm_temp, _mm512_set1_epi32(static_cast<int>(keys[r * 2 + 1]))));
+                }
+
+                _mm512_storeu_si512(out + i, _mm512_unpacklo_epi32(zmm_v0, zmm_v1));
+                _mm512_storeu_si512(out + i + 8, _mm512_unpackhi_epi32(zmm_v0, zmm_v1));
+            }
+#endif
+#if defined(__AVX2__)
+            // x64 - AVX2, 8 blocks per pass
+            for (; count - i >= 8; i += 8) {
+                __m256 ymm_a = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+                __m256 ymm_b = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 4)));
+                __m256i ymm_v0 = _mm256_castps_si256(_mm256_shuffle_ps(ymm_a, ymm_b, _MM_SHUFFLE(2, 0, 2, 0)));
+                __m256i ymm_v1 = _mm256_castps_si256(_mm256_shuffle_ps(ymm_a, ymm_b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+                for (std::uint32_t r = 0; r < Rounds; ++r) {
+                    __m256i ymm_temp = _mm256_add_epi32(_mm256_xor_si256(_mm256_slli_epi32(ymm_v1, 4), _mm256_srli_epi32(ymm_v1, 5)), ymm_v1);
+                    ymm_v0 = _mm256_add_epi32(ymm_v0, _mm256_xor_si256(ymm_temp, _mm256_set1_epi32(static_cast<int>(keys[r * 2]))));
+                    ymm_temp = _mm256_add_epi32(_mm256_xor_si256(_mm256_slli_epi32(ymm_v0, 4), _mm256_srli_epi32(ymm_v0, 5)), ymm_v0);
+                    ymm_v1 = _mm256_add_epi32(ymm_v1, _mm256_xor_si256(ymm_temp, _mm256_set1_epi32(static_cast<int>(keys[r * 2 + 1]))));
+                }
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_unpacklo_epi32(ymm_v0, ymm_v1));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 4), _mm256_unpackhi_epi32(ymm_v0, ymm_v1));
+            }
+#endif
+            // x86/x64 - SSE2, 4 blocks per pass
+            for (; count - i >= 4; i += 4) {
+                __m128 xmm_a = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+                __m128 xmm_b = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 2)));
+                __m128i xmm_v0 = _mm_castps_si128(_mm_shuffle_ps(xmm_a, xmm_b, _MM_SHUFFLE(2, 0, 2, 0)));
+                __m128i xmm_v1 = _mm_castps_si128(_mm_shuffle_ps(xmm_a, xmm_b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+                for (std::uint32_t r = 0; r < Rounds; ++r) {
+                    __m128i xmm_temp = _mm_add_epi32(_mm_xor_si128(_mm_slli_epi32(xmm_v1, 4), _mm_srli_epi32(xmm_v1, 5)), xmm_v1);
+                    xmm_v0 = _mm_add_epi32(xmm_v0, _mm_xor_si128(xmm_temp, _mm_set1_epi32(static_cast<int>(keys[r * 2]))));
+                    xmm_temp = _mm_add_epi32(_mm_xor_si128(_mm_slli_epi32(xmm_v0, 4), _mm_srli_epi32(xmm_v0, 5)), xmm_v0);
+                    xmm_v1 = _mm_add_epi32(xmm_v1, _mm_xor_si128(xmm_temp, _mm_set1_epi32(static_cast<int>(keys[r * 2 + 1]))));
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi32(xmm_v0, xmm_v1));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 2), _mm_unpackhi_epi32(xmm_v0, xmm_v1));
+            }
+#endif
+
+            for (; i < count; ++i) {
+                out[i] = xtea_encrypt_block(in[i], keys, Rounds);
+            }
+#endif
+        }
+
+        // Decrypts Width consecutive blocks straight into one register and returns their low halves;
+        // for 4-byte element types these are the plaintext values, so nothing is stored to memory
+#if defined(__aarch64__) || defined(_M_ARM64)
+        template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE uint32x4_t xtea_decrypt_low_x4(const std::uint64_t *in, const std::uint32_t *keys) {
+            uint32x4x2_t neon_block = vld2q_u32(reinterpret_cast<const std::uint32_t*>(in));
+            xtea_decrypt_rounds<Rounds>(neon_block.val[0], neon_block.val[1], keys);
+            return neon_block.val[0];
+        }
+#else
+        template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE __m128i xtea_decrypt_low_x4(const std::uint64_t *in, const std::uint32_t *keys) {
+            __m128 xmm_a = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+            __m128 xmm_b = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2)));
+            __m128i xmm_v0 = _mm_castps_si128(_mm_shuffle_ps(xmm_a, xmm_b, _MM_SHUFFLE(2, 0, 2, 0)));
+            __m128i xmm_v1 = _mm_castps_si128(_mm_shuffle_ps(xmm_a, xmm_b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+            xtea_decrypt_rounds<Rounds>(xmm_v0, xmm_v1, keys);
+            return xmm_v0;
+        }
+#if defined(__AVX2__)
+        // shuffle_ps works within 128-bit halves, so the v0 lanes come out as 0 1 4 5 2 3 6 7
+        template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE __m256i xtea_decrypt_low_x8(const std::uint64_t *in, const std::uint32_t *keys) {
+            __m256 ymm_a = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)));
+            __m256 ymm_b = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 4)));
+            __m256i ymm_v0 = _mm256_castps_si256(_mm256_shuffle_ps(ymm_a, ymm_b, _MM_SHUFFLE(2, 0, 2, 0)));
+            __m256i ymm_v1 = _mm256_castps_si256(_mm256_shuffle_ps(ymm_a, ymm_b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+            xtea_decrypt_rounds<Rounds>(ymm_v0, ymm_v1, keys);
+            return _mm256_permute4x64_epi64(ymm_v0, _MM_SHUFFLE(3, 1, 2, 0));
+        }
+#endif
+#if defined(__AVX512F__)
+        template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE __m512i xtea_decrypt_low_x16(const std::uint64_t *in, const std::uint32_t *keys) {
+            __m512i zmm_a = _mm512_loadu_si512(in);
+            __m512i zmm_b = _mm512_loadu_si512(in + 8);
+            const __m512i even = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0);
+            __m512i zmm_v0 = _mm512_permutex2var_epi32(zmm_a, even, zmm_b);
+            __m512i zmm_v1 = _mm512_permutex2var_epi32(zmm_a, _mm512_add_epi32(even, _mm512_set1_epi32(1)), zmm_b);
+
+            xtea_decrypt_rounds<Rounds>(zmm_v0, zmm_v1, keys);
+            return zmm_v0;
+        }
+#endif
+#endif
+
+        template<std::size_t Lanes, std::uint32_t Rounds> OBFUSCXX_FORCEINLINE void xtea_decrypt_lanes(std::uint32_t *v0, std::uint32_t *v1, const lane_schedule<Lanes> &schedule) {
+            static_assert(Lanes % 4 == 0, "lane count must be padded to a multiple of 4");
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+            // ARM64 - NEON, 4 lanes per pass
+            for (std::size_t l = 0; l < Lanes; l += 4) {
+                uint32x4_t neon_v0 = vld1q_u32(v0 + l);
+                uint32x4_t neon_v1 = vld1q_u32(v1 + l);
+
+                for (std::uint32_t r = Rounds; r-- > 0;) {
+                    const uint32x4_t neon_mask = vld1q_u32(&schedule.masks[r][l]);
+                    uint32x4_t neon_temp = vaddq_u32(veorq_u32(vshlq_n_u32(neon_v0, 4), vshrq_n_u32(neon_v0, 5)), neon_v0);
+                    neon_temp = veorq_u32(neon_temp, vld1q_u32(&schedule.keys[r][1][l]));
+                    neon_v1 = vsubq_u32(neon_v1, vandq_u32(neon_temp, neon_mask));
+                    neon_temp = vaddq_u32(veorq_u32(vshlq_n_u32(neon_v1, 4), vshrq_n_u32(neon_v1, 5)), neon_v1);
+                    neon_temp = veorq_u32(neon_temp, vld1q_u32(&schedule.keys[r][0][l]));
+                    neon_v0 = vsubq_u32(neon_v0, vandq_u32(neon_temp, neon_mask));
+                }
+
+                vst1q_u32(v0 + l, neon_v0);
+                vst1q_u32(v1 + l, neon_v1);
+            }
+#else
+            std::size_t l = 0;
+#if defined(__AVX2__)
+            // x64 - AVX2, 8 lanes per pass
+            for (; l + 8 <= Lanes; l += 8) {
+                __m256i ymm_v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v0 + l));
+                __m256i ymm_v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v1 + l));
+
+                for (std::uint32_t r = Rounds; r-- > 0;) {
+                    const __m256i ymm_mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&schedule.masks[r][l]));
+                    __m256i ymm_temp = _mm256_add_epi32(_mm256_xor_si256(_mm256_slli_epi32(ymm_v0, 4), _mm256_srli_epi32(ymm_v0, 5)), ymm_v0);
+                    ymm_temp = _mm256_xor_si256(ymm_temp, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&schedule.keys[r][1][l])));
+                    ymm_v1 = _mm256_sub_epi32(ymm_v1, _mm256_and_si256(ymm_temp, ymm_mask));
+                    ymm_temp = _mm256_add_epi32(_mm256_xor_si256(_mm256_slli_epi32(ymm_v1, 4), _mm256_srli_epi32(ymm_v1, 5)), ymm_v1);
+                    ymm_temp = _mm256_xor_si256(ymm_temp, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&schedule.keys[r][0][l])));
+                    ymm_v0 = _mm256_sub_epi32(ymm_v0, _mm256_and_si256(ymm_temp, ymm_mask));
+                }
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(v0 + l), ymm_v0);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(v1 + l), ymm_v1);
+            }
+#endif
+            // x86/x64 - SSE2, 4 lanes per pass
+            for (; l < Lanes; l += 4) {
+                __m128i xmm_v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v0 + l));
+                __m128i xmm_v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v1 + l));
+
+                for (std::uint32_t r = Rounds; r-- > 0;) {
+                    const __m128i xmm_mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&schedule.masks[r][l]));
+                    __m128i xmm_temp = _mm_add_epi32(_mm_xor_si128(_mm_slli_epi32(xmm_v0, 4), _mm_srli_epi32(xmm_v0, 5)), xmm_v0);
+                    xmm_temp = _mm_xor_si128(xmm_temp, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&schedule.keys[r][1][l])));
+                    xmm_v1 = _mm_sub_epi32(xmm_v1, _mm_and_si128(xmm_temp, xmm_mask));
+                    xmm_temp = _mm_add_epi32(_mm_xor_si128(_mm_slli_epi32(xmm_v1, 4), _mm_srli_epi32(xmm_v1, 5)), xmm_v1);
+                    xmm_temp = _mm_xor_si128(xmm_temp, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&schedule.keys[r][0][l])));
+                    xmm_v0 = _mm_sub_epi32(xmm_v0, _mm_and_si128(xmm_temp, xmm_mask));
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(v0 + l), xmm_v0);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(v1 + l), xmm_v1);
+            }
+#endif
+        }
+
+        // Ciphertext-domain scan: returns the index of the first block equal to needle, or size
+        OBFUSCXX_FORCEINLINE std::size_t find_u64(const std::uint64_t *data, std::size_t size, std::uint64_t needle) {
+            std::size_t i = 0;
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+            // ARM64 - NEON
+            const uint64x2_t neon_needle = vdupq_n_u64(needle);
+            for (; i + 2 <= size; i += 2) {
+                uint64x2_t neon_eq = vceqq_u64(vld1q_u64(data + i), neon_needle);
+                if (vgetq_lane_u64(neon_eq, 0)) return i;
+                if (vgetq_lane_u64(neon_eq, 1)) return i + 1;
+            }
+#elif defined(__AVX512F__)
+            // x64 - AVX-512
+            const __m512i zmm_needle = _mm512_set1_epi64(static_cast<long long>(needle));
+            for (; i + 8 <= size; i += 8) {
+                __mmask8 mask = _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(data + i), zmm_needle);
+                if (mask) return i + std::countr_zero(static_cast<unsigned>(mask));
+            }
+#elif defined(__AVX2__)
+            // x64 - AVX2
+            const __m256i ymm_needle = _mm256_set1_epi64x(static_cast<long long>(needle));
+            for (; i + 4 <= size; i += 4) {
+                __m256i ymm_eq = _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), ymm_needle);
+                int mask = _mm256_movemask_pd(_mm256_castsi256_pd(ymm_eq));
+                if (mask) return i + std::countr_zero(static_cast<unsigned>(mask));
+            }
+#else
+            // x86/x64 - SSE2 (64-bit compare emulated with two 32-bit compares)
+            const __m128i xmm_needle = _mm_set_epi32(
+                static_cast<int>(needle >> 32), static_cast<int>(needle),
+                static_cast<int>(needle >> 32), static_cast<int>(needle));
+            for (; i + 2 <= size; i += 2) {
+                __m128i xmm_eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), xmm_needle);
+                xmm_eq = _mm_and_si128(xmm_eq, _mm_shuffle_epi32(xmm_eq, _MM_SHUFFLE(2, 3, 0, 1)));
+                int mask = _mm_movemask_pd(_mm_castsi128_pd(xmm_eq));
+                if (mask) return i + std::countr_zero(static_cast<unsigned>(mask));
+            }
+#endif
+
+            for (; i < size; ++i) {
+                if (data[i] == needle) return i;
+            }
+            return size;
+        }
+
+        // Ciphertext-domain scan: returns the number of blocks equal to needle
+        OBFUSCXX_FORCEINLINE std::size_t count_u64(const std::uint64_t *data, std::size_t size, std::uint64_t needle) {
+            std::size_t i = 0;
+            std::size_t count = 0;
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+            // ARM64 - NEON
+            const uint64x2_t neon_needle = vdupq_n_u64(needle);
+            uint64x2_t neon_acc = vdupq_n_u64(0);
+            for (; i + 2 <= size; i += 2) {
+                neon_acc = vsubq_u64(neon_acc, vceqq_u64(vld1q_u64(data + i), neon_needle));
+            }
+            count = vgetq_lane_u64(neon_acc, 0) + vgetq_lane_u64(neon_acc, 1);
+#elif defined(__AVX512F__)
+            // x64 - AVX-512
+            const __m512i zmm_needle = _mm512_set1_epi64(static_cast<long long>(needle));
+            for (; i + 8 <= size; i += 8) {
+                __mmask8 mask = _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(data + i), zmm_needle);
+                count += std::popcount(static_cast<unsigned>(mask));
+            }
+#elif defined(__AVX2__)
+            // x64 - AVX2
+            const __m256i ymm_needle = _mm256_set1_epi64x(static_cast<long long>(needle));
+            for (; i + 4 <= size; i += 4) {
+                __m256i ymm_eq = _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), ymm_needle);
+                count += std::popcount(static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(ymm_eq))));
+            }
+#else
+            // x86/x64 - SSE2 (64-bit compare emulated with two 32-bit compares)
+            const __m128i xmm_needle = _mm_set_epi32(
+                static_cast<int>(needle >> 32), static_cast<int>(needle),
+                static_cast<int>(needle >> 32), static_cast<int>(needle));
+            for (; i + 2 <= size; i += 2) {
+                __m128i xmm_eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), xmm_needle);
+                xmm_eq = _mm_and_si128(xmm_eq, _mm_shuffle_epi32(xmm_eq, _MM_SHUFFLE(2, 3, 0, 1)));
+                count += std::popcount(static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(xmm_eq))));
+            }
+#endif
+
+            for (; i < size; ++i) {
+                count += data[i] == needle;
+            }
+            return count;
+        }
+#else
+        // OBFUSCXX_LEAN: no intrinsic headers, the kernels are reached through the ngu_obfuscxx_* entry
+        // points. The inline namespace only keeps these forwarders apart from the intrinsic kernels that
+        // obfuscxx_kernels.cpp instantiates; the public templates keep one name in both modes, so the
+        // translation units of one program must otherwise all use the same mode
+        inline namespace lean {
+            template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE void xtea_decrypt_blocks(const std::uint64_t *in, std::uint64_t *out, std::size_t count, const std::uint32_t *keys) {
+                ngu_obfuscxx_decrypt_blocks(in, out, count, keys, Rounds);
+            }
+
+            template<std::uint32_t Rounds> OBFUSCXX_FORCEINLINE void xtea_encrypt_blocks(const std::uint64_t *in, std::uint64_t *out, std::size_t count, const std::uint32_t *keys) {
+                ngu_obfuscxx_encrypt_blocks(in, out, count, keys, Rounds);
+            }
+
+            // Portable masked rounds, the lane loops are left to the auto-vectorizer
+            template<std::size_t Lanes, std::uint32_t Rounds> OBFUSCXX_FORCEINLINE void xtea_decrypt_lanes(std::uint32_t *v0, std::uint32_t *v1, const lane_schedule<Lanes> &schedule) {
+                static_assert(Lanes % 4 == 0, "lane count must be padded to a multiple of 4");
+
+                for (std::uint32_t r = Rounds; r-- > 0;) {
+                    for (std::size_t l = 0; l < Lanes; ++l) {
+                        v1[l] -= ((((v0[l] << 4) ^ (v0[l] >> 5)) + v0[l]) ^ schedule.keys[r][1][l]) & schedule.masks[r][l];
+                    }
+                    for (std::size_t l = 0; l < Lanes; ++l) {
+                        v0[l] -= ((((v1[l] << 4) ^ (v1[l] >> 5)) + v1[l]) ^ schedule.keys[r][0][l]) & schedule.masks[r][l];
+                    }
+                }
+            }
+
+            OBFUSCXX_FORCEINLINE std::size_t find_u64(const std::uint64_t *data, std::size_t size, std::uint64_t needle) {
+                return ngu_obfuscxx_find_u64(data, size, needle);
+            }
+
+            OBFUSCXX_FORCEINLINE std::size_t count_u64(const std::uint64_t *data, std::size_t size, std::uint64_t needle) {
+                return ngu_obfuscxx_count_u64(data, size, needle);
+            }
+        }
+#endif
     }
 
 #define OBFUSCXX_HASH( s ) detail::hash_compile_time( s )
 #define OBFUSCXX_HASH_RT( s ) detail::hash_runtime( s )
 
+// OBFUSCXX_SEED replaces the build time with a user-controlled value, so unchanged TUs produce
+// byte-identical objects across rebuilds (ccache/sccache, reproducible builds)
+#if defined(OBFUSCXX_SEED)
+#define OBFUSCXX_BUILD_ENTROPY detail::splitmix64(static_cast<std::uint64_t>(OBFUSCXX_SEED))
+#else
+#define OBFUSCXX_BUILD_ENTROPY OBFUSCXX_HASH(__TIME__)
+#endif
+
 #if defined(_KERNEL_MODE) || defined(_WIN64_DRIVER)
 #define OBFUSCXX_ENTROPY ( \
 detail::splitmix64( \
@@ -127,12 +922,25 @@ detail::splitmix64( \
 detail::splitmix64( \
 OBFUSCXX_HASH(__FILE__) + \
 ((std::uint64_t)__LINE__ * 0x9e3779b97f4a7c15ULL) + \
-(OBFUSCXX_HASH(__TIME__) ^ ((std::uint64_t)__COUNTER__ << 32)) \
+(OBFUSCXX_BUILD_ENTROPY ^ ((std::uint64_t)__COUNTER__ << 32)) \
 ) \
 )
 #endif
 
-    enum class obf_level : std::uint8_t { Low, Medium, High };
+#if !defined(_KERNEL_MODE) && !defined(_WIN64_DRIVER)
+    // Per-site entropy without the preprocessor, for code importing ngu.obfuscxx where OBFUSCXX_ENTROPY
+    // is not visible: obfuscxx<int, 1, obf_level::Low, site_entropy()>{ 42 }. The builtins are evaluated
+    // at the call site and, unlike std::source_location, need no header on the importing side; sites on
+    // one line are told apart by salt
+    consteval std::uint64_t site_entropy(std::uint64_t salt = 0, const char *file = __builtin_FILE(),
+                                         std::uint32_t line = __builtin_LINE()) {
+        return detail::splitmix64(
+            OBFUSCXX_HASH_RT(file) +
+            (static_cast<std::uint64_t>(line) * 0x9e3779b97f4a7c15ULL) +
+            (OBFUSCXX_BUILD_ENTROPY ^ (salt << 32))
+        );
+    }
+#endif
 
     template<class Type, std::size_t Size = 1, obf_level Level = obf_level::Low, std::uint64_t Entropy = OBFUSCXX_ENTROPY>
     class obfuscxx {
@@ -142,27 +950,31 @@ OBFUSCXX_HASH(__FILE__) + \
         static constexpr bool is_char = std::is_same_v<Type, char> || std::is_same_v<Type, const char>;
         static constexpr bool is_wchar = std::is_same_v<Type, wchar_t> || std::is_same_v<Type, const wchar_t>;
 
+        // Any other trivially-copyable type is bit-cast into consecutive 64-bit blocks (little-endian)
+        static constexpr bool is_object =
+                !(std::is_arithmetic_v<Type> || std::is_enum_v<Type> || std::is_pointer_v<Type>) || sizeof(Type) > 8;
+        static constexpr std::size_t block_count = is_object ? (sizeof(Type) + 7) / 8 : 1;
+
+        static_assert(!is_object || std::is_trivially_copyable_v<Type>, "obfuscxx: object types must be trivially copyable");
+        static_assert(!is_object || is_single, "obfuscxx: object types are stored one per instance");
+        static_assert(!is_object || detail::padding_free<Type>,
+            "obfuscxx: object types must not contain padding bytes, which compile-time encryption cannot read; "
+            "reorder the fields or add explicit padding members (types without a default constructor must also "
+            "have unique object representations, i.e. no floating-point members)");
+
         struct passkey { explicit passkey() = default; };
 
+        friend struct detail::instance_access;
+
         static constexpr std::uint64_t seed{ Entropy };
-        static constexpr std::uint64_t iv[8] = {
-            0xcbf43b227a01fe5aULL ^ seed,
-            0x32703be7aaa7c38fULL ^ detail::ror64(seed, 13),
-            0xb589959b3d854bbcULL ^ detail::rol64(seed, 29),
-            0x73b3ef5578a97c8aULL ^ detail::ror64(seed, 41),
-            0x92afafd27c6e16e9ULL ^ detail::rol64(seed, 7),
-            0xee8291ae3070720aULL ^ detail::ror64(seed, 53),
-            0xe2c0d70f73d6c4a0ULL ^ detail::rol64(seed, 19),
-            0x82742897b912855bULL ^ detail::ror64(seed, 37),
-        };
+        static constexpr detail::xtea_key key = detail::make_xtea_key(seed, Level);
+        static constexpr const std::uint64_t (&iv)[8] = key.iv;
         static constexpr std::uint64_t iv_size = (sizeof(iv) / 8) - 1;
-        static constexpr std::uint64_t unique_index = seed & iv_size;
-        static constexpr std::uint64_t unique_value = iv[unique_index];
 
-        static constexpr std::uint32_t xtea_rounds =
-                (Level == obf_level::Low) ? 2 : (Level == obf_level::Medium) ? 6 : (6 + ((unique_index & 0x7) * 2));
+        static constexpr std::uint32_t xtea_rounds = key.rounds;
+        static constexpr std::uint32_t xtea_delta = key.delta;
 
-        static constexpr std::uint32_t xtea_delta = (0x9E3779B9 ^ static_cast<std::uint32_t>(unique_value)) | 1;
+        static constexpr detail::xtea_schedule<xtea_rounds> schedule = detail::make_xtea_schedule<xtea_rounds>(iv, xtea_delta);
 
         static constexpr std::uint64_t encrypt(Type value) {
             std::uint64_t val = to_uint64(value);
@@ -185,6 +997,12 @@ OBFUSCXX_HASH(__FILE__) + \
         static OBFUSCXX_FORCEINLINE Type decrypt(std::uint64_t value) {
             OBFUSCXX_MEM_BARRIER(value)
 
+#if defined(OBFUSCXX_OUTLINE_DECRYPT) || defined(OBFUSCXX_LEAN)
+            const std::uint32_t *keys = schedule.keys;
+            OBFUSCXX_MEM_BARRIER(keys)
+
+            return from_uint64(detail::xtea_decrypt_outlined<xtea_rounds>(value, keys));
+#else
             std::uint32_t v0 = static_cast<std::uint32_t>(value);
             std::uint32_t v1 = static_cast<std::uint32_t>(value >> 32);
             std::uint32_t sum = xtea_delta * xtea_rounds;
@@ -283,7 +1101,7 @@ OBFUSCXX_HASH(__FILE__) + \
 
                     __m256i mm256_v1 = _mm256_set1_epi32(v1);
                     mm256_v1 = _mm256_sub_epi32(mm256_v1, mm256_temp);
-                    v1 = _mm256_extract_epi32(mm256_v1, 0);
+                    v1 = _mm_cvtsi128_si32(_mm256_castsi256_si128(mm256_v1));
                 } else {
                     __m128i mm128_v0 = _mm_set1_epi32(v0);
                     __m128i mm128_left = _mm_slli_epi32(mm128_v0, 4);
@@ -296,7 +1114,7 @@ OBFUSCXX_HASH(__FILE__) + \
 
                     __m128i mm128_v1 = _mm_set1_epi32(v1);
                     mm128_v1 = _mm_sub_epi32(mm128_v1, mm128_temp);
-                    v1 = _mm_extract_epi32(mm128_v1, 0);
+                    v1 = _mm_cvtsi128_si32(mm128_v1);
                 }
 
                 sum -= xtea_delta;
@@ -316,7 +1134,7 @@ OBFUSCXX_HASH(__FILE__) + \
 
                     __m256i mm256_v0 = _mm256_set1_epi32(v0);
                     mm256_v0 = _mm256_sub_epi32(mm256_v0, mm256_temp);
-                    v0 = _mm256_extract_epi32(mm256_v0, 0);
+                    v0 = _mm_cvtsi128_si32(_mm256_castsi256_si128(mm256_v0));
                 } else {
                     __m128i mm128_v1 = _mm_set1_epi32(v1);
                     __m128i mm128_left = _mm_slli_epi32(mm128_v1, 4);
@@ -329,43 +1147,94 @@ OBFUSCXX_HASH(__FILE__) + \
 
                     __m128i mm128_v0 = _mm_set1_epi32(v0);
                     mm128_v0 = _mm_sub_epi32(mm128_v0, mm128_temp);
-                    v0 = _mm_extract_epi32(mm128_v0, 0);
+                    v0 = _mm_cvtsi128_si32(mm128_v0);
                 }
             }
 
 #endif
 
             return from_uint64((static_cast<std::uint64_t>(v1) << 32) | v0);
+#endif
         }
 
         static constexpr std::uint64_t to_uint64(Type value) {
-            if constexpr (std::is_pointer_v<Type>) {
-                return reinterpret_cast<std::uint64_t>(value);
-            } else if constexpr (std::is_floating_point_v<Type>) {
-                if constexpr (sizeof(Type) == 4) {
-                    return __builtin_bit_cast(std::uint32_t, value);
-                } else {
-                    return __builtin_bit_cast(std::uint64_t, value);
+            return detail::to_block(value);
+        }
+
+        static OBFUSCXX_FORCEINLINE Type from_uint64(std::uint64_t value) {
+            return detail::from_block<Type>(value);
+        }
+
+        struct object_bytes { unsigned char bytes[sizeof(Type)]; };
+        struct object_blocks { std::uint64_t blocks[block_count]; };
+
+        static constexpr void encrypt_to(Type value, auto *out) {
+            if constexpr (is_object) {
+                const auto raw = std::bit_cast<object_bytes>(value);
+                for (std::size_t b = 0; b < block_count; ++b) {
+                    std::uint64_t block = 0;
+                    for (std::size_t j = 0; j < 8 && b * 8 + j < sizeof(Type); ++j) {
+                        block |= static_cast<std::uint64_t>(raw.bytes[b * 8 + j]) << (j * 8);
+                    }
+                    out[b] = detail::xtea_encrypt_block(block, schedule.keys, xtea_rounds);
                 }
             } else {
-                return static_cast<std::uint64_t>(value);
+                out[0] = encrypt(value);
             }
         }
 
-        static OBFUSCXX_FORCEINLINE Type from_uint64(std::uint64_t value) {
-            if constexpr (std::is_pointer_v<Type>) {
-                return reinterpret_cast<Type>(value);
-            } else if constexpr (std::is_floating_point_v<Type>) {
-                if constexpr (sizeof(Type) == 4) {
-                    return __builtin_bit_cast(Type, static_cast<std::uint32_t>(value));
-                } else {
-                    return __builtin_bit_cast(Type, value);
+        // Decrypts blocks [first, first + count) in one multi-lane pass into the same slots of out
+        OBFUSCXX_FORCEINLINE void decrypt_blocks(std::size_t first, std::size_t count, std::uint64_t *out) const {
+            decrypt_chunk(const_cast<const std::uint64_t*>(data) + first, out + first, count);
+        }
+
+        // Multi-lane decrypt of count ciphertext blocks. Ciphertext and key table are passed through a
+        // barrier, as in decrypt(), so neither can be constant-folded into the call site; outlined under
+        // OBFUSCXX_OUTLINE_DECRYPT
+        static OBFUSCXX_FORCEINLINE void decrypt_chunk(const std::uint64_t *in, std::uint64_t *out, std::size_t count) {
+            const std::uint32_t *keys = schedule.keys;
+            OBFUSCXX_MEM_BARRIER(in)
+            OBFUSCXX_MEM_BARRIER(keys)
+
+#if defined(OBFUSCXX_OUTLINE_DECRYPT) && !defined(OBFUSCXX_LEAN)
+            detail::xtea_decrypt_blocks_outlined<xtea_rounds>(in, out, count, keys);
+#else
+            detail::xtea_decrypt_blocks<xtea_rounds>(in, out, count, keys);
+#endif
+        }
+
+#if !defined(_KERNEL_MODE) && !defined(_WIN64_DRIVER)
+        // Encrypts values into [offset, offset + values.size()) in chunks of converted plaintext
+        OBFUSCXX_FORCEINLINE void encrypt_range(std::size_t offset, std::span<const Type> values) {
+            constexpr std::size_t chunk_blocks = 64;
+            std::uint64_t plain[chunk_blocks];
+
+            std::size_t n = offset < Size ? Size - offset : 0;
+            if (n > values.size()) n = values.size();
+
+            auto *out = const_cast<std::uint64_t*>(data) + offset;
+            for (std::size_t i = 0; i < n; i += chunk_blocks) {
+                const std::size_t count = (n - i < chunk_blocks) ? n - i : chunk_blocks;
+                for (std::size_t j = 0; j < count; ++j) {
+                    plain[j] = to_uint64(values[i + j]);
                 }
-            } else {
-                return static_cast<Type>(value);
+                detail::xtea_encrypt_blocks<xtea_rounds>(plain, out + i, count, schedule.keys);
             }
+
+            detail::wipe(plain, sizeof(plain));
         }
+#endif
 
+        template<class T> static OBFUSCXX_FORCEINLINE T load_plain(const object_blocks &plain, std::size_t offset) {
+            struct { unsigned char bytes[sizeof(T)]; } raw;
+            const auto *src = reinterpret_cast<const unsigned char*>(plain.blocks) + offset;
+            for (std::size_t b = 0; b < sizeof(T); ++b) {
+                raw.bytes[b] = src[b];
+            }
+            return std::bit_cast<T>(raw);
+        }
+
+#if !defined(OBFUSCXX_LEAN)
         static OBFUSCXX_FORCEINLINE bool cpu_has_avx2() {
             static const bool cached = []() {
                 int cpuInfo[4]{};
@@ -374,16 +1243,19 @@ OBFUSCXX_HASH(__FILE__) + \
             }();
             return cached;
         }
+#endif
 
     public:
+        using value_type = Type;
+
         explicit consteval obfuscxx(passkey) {
-            for (std::size_t i = 0; i < Size; i++) {
+            for (std::size_t i = 0; i < Size * block_count; i++) {
                 data[i] = seed ^ iv[i & iv_size];
             }
         }
 
         explicit consteval obfuscxx(Type val) : obfuscxx(passkey{}) {
-            data[0] = encrypt(val);
+            encrypt_to(val, data);
         }
 
         explicit consteval obfuscxx(Type (&val)[Size]) : obfuscxx(passkey{}) {
@@ -400,13 +1272,32 @@ OBFUSCXX_HASH(__FILE__) + \
 
         consteval obfuscxx(const std::initializer_list<Type> &list) : obfuscxx(passkey{}) {
             for (std::size_t i{}; const auto &v: list)
-                data[i++] = encrypt(v);
+                encrypt_to(v, data + block_count * i++);
         }
 
         OBFUSCXX_FORCEINLINE Type get() const requires is_single {
-            volatile const std::uint64_t *ptr = &data[0];
-            std::uint64_t val = *ptr;
-            return decrypt(val);
+            if constexpr (is_object) {
+                object_blocks plain;
+                decrypt_blocks(0, block_count, plain.blocks);
+                return load_plain<Type>(plain, 0);
+            } else {
+                volatile const std::uint64_t *ptr = &data[0];
+                std::uint64_t val = *ptr;
+                return decrypt(val);
+            }
+        }
+
+        // Decrypts only the blocks covering one field of an object, e.g. config.get<&config_t::port>()
+        template<auto Member> OBFUSCXX_FORCEINLINE auto get() const requires (is_object && std::is_member_object_pointer_v<decltype(Member)>) {
+            using Field = std::remove_cvref_t<decltype(static_cast<const Type*>(nullptr)->*Member)>;
+            static_assert(!std::is_array_v<Field>, "obfuscxx: array fields cannot be returned by value");
+
+            const std::size_t offset = detail::member_offset(Member);
+            const std::size_t first = offset / 8;
+
+            object_blocks plain;
+            decrypt_blocks(first, (offset + sizeof(Field) + 7) / 8 - first, plain.blocks);
+            return load_plain<Field>(plain, offset);
         }
 
         OBFUSCXX_FORCEINLINE Type get(std::size_t i) const requires is_array {
@@ -415,22 +1306,92 @@ OBFUSCXX_HASH(__FILE__) + \
             return decrypt(val);
         }
 
+        // Decrypts the first count elements in multi-lane chunks
         OBFUSCXX_FORCEINLINE void copy_to(Type *out, std::size_t count) const requires is_array {
+            constexpr std::size_t chunk_blocks = 64;
+            std::uint64_t plain[chunk_blocks];
+
+            const std::uint64_t *in = const_cast<const std::uint64_t*>(data);
+
             std::size_t n = (count < Size) ? count : Size;
-            for (std::size_t i = 0; i < n; ++i) {
-                volatile const std::uint64_t *ptr = &data[i];
-                out[i] = decrypt(*ptr);
+            for (std::size_t i = 0; i < n; i += chunk_blocks) {
+                const std::size_t chunk = (n - i < chunk_blocks) ? n - i : chunk_blocks;
+                decrypt_chunk(in + i, plain, chunk);
+                for (std::size_t j = 0; j < chunk; ++j) {
+                    out[i + j] = from_uint64(plain[j]);
+                }
             }
+
+            detail::wipe(plain, sizeof(plain));
         }
 
+#if !defined(OBFUSCXX_LEAN)
+        // Decrypts Width elements starting at offset straight into one register: __m128/__m128i, __m256/__m256i
+        // with AVX2, __m512/__m512i with AVX-512, float32x4_t/int32x4_t/uint32x4_t on NEON. offset + Width
+        // must not exceed Size; not available with OBFUSCXX_LEAN
+        template<std::size_t Width> OBFUSCXX_FORCEINLINE auto load_decrypted(std::size_t offset) const
+            requires (is_array && sizeof(Type) == 4 && !std::is_pointer_v<Type> && Width <= Size) {
+            const std::uint64_t *in = const_cast<const std::uint64_t*>(data) + offset;
+            OBFUSCXX_MEM_BARRIER(in)
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+            static_assert(Width == 4, "obfuscxx: NEON registers hold 4 lanes");
+
+            const uint32x4_t lanes = detail::xtea_decrypt_low_x4<xtea_rounds>(in, schedule.keys);
+            if constexpr (std::is_floating_point_v<Type>) {
+                return vreinterpretq_f32_u32(lanes);
+            } else if constexpr (std::is_signed_v<Type>) {
+                return vreinterpretq_s32_u32(lanes);
+            } else {
+                return lanes;
+            }
+#else
+            if constexpr (Width == 4) {
+                const __m128i lanes = detail::xtea_decrypt_low_x4<xtea_rounds>(in, schedule.keys);
+                if constexpr (std::is_floating_point_v<Type>) return _mm_castsi128_ps(lanes);
+                else return lanes;
+            }
+#if defined(__AVX2__)
+            else if constexpr (Width == 8) {
+                const __m256i lanes = detail::xtea_decrypt_low_x8<xtea_rounds>(in, schedule.keys);
+                if constexpr (std::is_floating_point_v<Type>) return _mm256_castsi256_ps(lanes);
+                else return lanes;
+            }
+#endif
+#if defined(__AVX512F__)
+            else if constexpr (Width == 16) {
+                const __m512i lanes = detail::xtea_decrypt_low_x16<xtea_rounds>(in, schedule.keys);
+                if constexpr (std::is_floating_point_v<Type>) return _mm512_castsi512_ps(lanes);
+                else return lanes;
+            }
+#endif
+            else {
+                static_assert(Width == 0, "obfuscxx: Width must be a native register width (4, 8 with AVX2, 16 with AVX-512)");
+            }
+#endif
+        }
+#endif
+
         OBFUSCXX_RUNTIME_WARNING OBFUSCXX_FORCEINLINE void set(Type val) requires is_single {
-            data[0] = encrypt(val);
+            encrypt_to(val, data);
         }
 
         OBFUSCXX_RUNTIME_WARNING OBFUSCXX_FORCEINLINE void set(Type val, std::size_t i) requires is_array {
             data[i] = encrypt(val);
         }
 
+#if !defined(_KERNEL_MODE) && !defined(_WIN64_DRIVER)
+        // Bulk runtime encrypt through the multi-lane kernel; the ciphertext is identical to element-wise
+        // set(). Values past Size are ignored
+        OBFUSCXX_RUNTIME_BULK_WARNING OBFUSCXX_FORCEINLINE void set_range(std::size_t offset, std::span<const Type> values) requires is_array {
+            encrypt_range(offset, values);
+        }
+
+        OBFUSCXX_RUNTIME_BULK_WARNING OBFUSCXX_FORCEINLINE void assign(std::span<const Type> values) requires is_array {
+            encrypt_range(0, values);
+        }
+#endif
+
         OBFUSCXX_RUNTIME_WARNING OBFUSCXX_FORCEINLINE void set(const std::initializer_list<Type> &list) requires is_array {
             for (std::size_t i{}; const auto &val: list) {
                 if (i < Size) {
@@ -440,7 +1401,11 @@ OBFUSCXX_HASH(__FILE__) + \
         }
 
         OBFUSCXX_FORCEINLINE Type operator()() const requires is_single {
-            return decrypt(data[0]);
+            if constexpr (is_object) {
+                return get();
+            } else {
+                return decrypt(data[0]);
+            }
         }
 
         OBFUSCXX_FORCEINLINE Type operator[](std::size_t i) const requires is_array {
@@ -494,7 +1459,7 @@ OBFUSCXX_HASH(__FILE__) + \
             return get() >= rhs.get();
         }
 
-        OBFUSCXX_FORCEINLINE Type operator+(const obfuscxx &rhs) const {
+        OBFUSCXX_FORCEINLINE Type operator+(const obfuscxx &rhs) const requires is_single {
             return get() + rhs.get();
         }
 
@@ -547,6 +1512,20 @@ OBFUSCXX_HASH(__FILE__) + \
         iterator end() const requires is_array { return {this, Size}; }
         static constexpr std::size_t size() { return Size; }
 
+        // Elements share one key schedule, so the needle is encrypted once and matched against the
+        // ciphertext without decrypting anything. Comparison is bitwise (e.g. 0.0f does not match -0.0f)
+        OBFUSCXX_FORCEINLINE iterator find(Type val) const requires is_array {
+            return {this, detail::find_u64(const_cast<const std::uint64_t*>(data), Size, encrypt(val))};
+        }
+
+        OBFUSCXX_FORCEINLINE std::size_t count(Type val) const requires is_array {
+            return detail::count_u64(const_cast<const std::uint64_t*>(data), Size, encrypt(val));
+        }
+
+        OBFUSCXX_FORCEINLINE bool contains(Type val) const requires is_array {
+            return find(val) != end();
+        }
+
         template<class CharType, std::size_t N> struct string_copy {
         private:
             static constexpr bool is_char = std::is_same_v<CharType, char> ||
@@ -591,6 +1570,64 @@ OBFUSCXX_HASH(__FILE__) + \
             return result;
         }
 
+        // Decrypts the string in small chunks up to the terminator and hands each one to
+        // sink(const CharType *, std::size_t), so no full-size plaintext copy is ever built
+        template<class Sink> OBFUSCXX_FORCEINLINE void for_each_chunk(Sink &&sink) const requires (is_char || is_wchar) {
+            constexpr std::size_t chunk_size = Size < 16 ? Size : 16;
+            std::remove_const_t<Type> chunk[chunk_size];
+
+            for (std::size_t i = 0; i < Size; i += chunk_size) {
+                std::size_t n = 0;
+                for (; n < chunk_size && i + n < Size; ++n) {
+                    volatile const std::uint64_t *ptr = &data[i + n];
+                    chunk[n] = decrypt(*ptr);
+                    if (chunk[n] == 0) {
+                        if (n) sink(static_cast<const Type*>(chunk), n);
+                        detail::wipe(chunk, sizeof(chunk));
+                        return;
+                    }
+                }
+                sink(static_cast<const Type*>(chunk), n);
+            }
+            detail::wipe(chunk, sizeof(chunk));
+        }
+
+#if !defined(_KERNEL_MODE) && !defined(_WIN64_DRIVER)
+        template<class Traits> friend std::basic_ostream<std::remove_const_t<Type>, Traits> &operator<<(
+            std::basic_ostream<std::remove_const_t<Type>, Traits> &os, const obfuscxx &str) requires (is_char || is_wchar) {
+            typename std::basic_ostream<std::remove_const_t<Type>, Traits>::sentry guard(os);
+            if (guard) {
+                // Padding needs the length first: one counting pass, so still no full plaintext copy
+                std::streamsize pad = 0;
+                if (os.width() > 0) {
+                    std::streamsize length = 0;
+                    str.for_each_chunk([&length](const Type*, std::size_t n) { length += static_cast<std::streamsize>(n); });
+                    pad = os.width() > length ? os.width() - length : 0;
+                }
+
+                const bool left = (os.flags() & os.adjustfield) == os.left;
+                const auto fill = [&os](std::streamsize n) {
+                    for (; n > 0; --n) {
+                        if (Traits::eq_int_type(os.rdbuf()->sputc(os.fill()), Traits::eof())) {
+                            os.setstate(os.badbit);
+                            return;
+                        }
+                    }
+                };
+
+                if (!left) fill(pad);
+                str.for_each_chunk([&os](const Type *chunk, std::size_t n) {
+                    if (os.rdbuf()->sputn(chunk, static_cast<std::streamsize>(n)) != static_cast<std::streamsize>(n)) {
+                        os.setstate(os.badbit);
+                    }
+                });
+                if (left) fill(pad);
+                os.width(0);
+            }
+            return os;
+        }
+#endif
+
         OBFUSCXX_FORCEINLINE array_copy<Type, Size> to_array() const requires (is_array) {
             array_copy<Type, Size> result{};
             if constexpr (is_array) {
@@ -602,18 +1639,278 @@ OBFUSCXX_HASH(__FILE__) + \
         }
 
     private:
-        OBFUSCXX_VOLATILE std::uint64_t data[Size]{};
+        OBFUSCXX_VOLATILE std::uint64_t data[Size * block_count]{};
+    };
+
+    namespace detail {
+        struct instance_access {
+            template<class Obfuscxx> static constexpr bool packable = Obfuscxx::is_single && !Obfuscxx::is_object;
+            template<class Obfuscxx> static constexpr std::uint32_t rounds = Obfuscxx::xtea_rounds;
+            template<class Obfuscxx> static constexpr const std::uint32_t *keys = Obfuscxx::schedule.keys;
+
+            template<class Obfuscxx> static OBFUSCXX_FORCEINLINE std::uint64_t block(const Obfuscxx &value) {
+                volatile const std::uint64_t *ptr = &value.data[0];
+                return *ptr;
+            }
+
+            template<class Obfuscxx> static OBFUSCXX_FORCEINLINE typename Obfuscxx::value_type value(std::uint64_t plain) {
+                return Obfuscxx::from_uint64(plain);
+            }
+
+#if !defined(_KERNEL_MODE) && !defined(_WIN64_DRIVER)
+            // Runtime bulk encrypt for companion containers whose values can only exist at runtime (function
+            // addresses cannot be bit-cast during constant evaluation), so no compile-time alternative exists
+            // and OBFUSCXX_RUNTIME_BULK_WARNING would fire on every instantiation. Not for values that could be
+            // encrypted at compile time
+            template<class Obfuscxx> static OBFUSCXX_FORCEINLINE void assign(Obfuscxx &target, std::size_t offset, std::span<const typename Obfuscxx::value_type> values) {
+                target.encrypt_range(offset, values);
+            }
+#endif
+
+            // Plaintext of a string instance during constant evaluation; MSVC keeps the ciphertext
+            // volatile, which constant evaluation cannot read
+            template<class Obfuscxx> static consteval void text(const Obfuscxx &value, char *out) {
+                for (std::size_t i = 0; i < Obfuscxx::size(); ++i) {
+                    out[i] = static_cast<char>(xtea_decrypt_block(value.data[i], Obfuscxx::schedule.keys, Obfuscxx::xtea_rounds));
+                }
+            }
+        };
+
+        template<class Part> struct is_obfuscxx_string : std::false_type {};
+        template<std::size_t Size, obf_level Level, std::uint64_t Entropy>
+        struct is_obfuscxx_string<obfuscxx<char, Size, Level, Entropy>> : std::true_type {};
+
+        // Upper bound of the characters one obf_concat part contributes, without the terminator
+        template<class Part> consteval std::size_t concat_capacity() {
+            if constexpr (std::is_array_v<Part>) {
+                static_assert(std::is_same_v<std::remove_const_t<std::remove_extent_t<Part>>, char>, "obf_concat: only char strings are supported");
+                return std::extent_v<Part> - 1;
+            } else if constexpr (is_obfuscxx_string<Part>::value) {
+                return Part::size() - 1;
+            } else if constexpr (std::is_same_v<Part, char>) {
+                return 1;
+            } else if constexpr (std::is_same_v<Part, bool>) {
+                return 5;
+            } else {
+                static_assert(std::is_integral_v<Part>, "obf_concat: parts are string literals, obfuscated strings, characters, bools or integers");
+                return (sizeof(Part) == 1 ? 3 : sizeof(Part) == 2 ? 5 : sizeof(Part) == 4 ? 10 : 20) + std::is_signed_v<Part>;
+            }
+        }
+
+        template<class Part> consteval void concat_append(char *out, std::size_t &length, const Part &part) {
+            if constexpr (std::is_array_v<Part>) {
+                for (std::size_t i = 0; i < std::extent_v<Part> && part[i]; ++i) {
+                    out[length++] = part[i];
+                }
+            } else if constexpr (is_obfuscxx_string<Part>::value) {
+                char plain[Part::size()]{};
+                instance_access::text(part, plain);
+                for (std::size_t i = 0; i < Part::size() && plain[i]; ++i) {
+                    out[length++] = plain[i];
+                }
+            } else if constexpr (std::is_same_v<Part, char>) {
+                out[length++] = part;
+            } else if constexpr (std::is_same_v<Part, bool>) {
+                for (const char *c = part ? "true" : "false"; *c; ++c) {
+                    out[length++] = *c;
+                }
+            } else {
+                // Decimal, the same digits std::to_chars produces
+                using Unsigned = std::make_unsigned_t<Part>;
+                Unsigned magnitude = static_cast<Unsigned>(part);
+                if constexpr (std::is_signed_v<Part>) {
+                    if (part < 0) {
+                        out[length++] = '-';
+                        magnitude = static_cast<Unsigned>(Unsigned{} - magnitude);
+                    }
+                }
+
+                char digits[20]{};
+                std::size_t count = 0;
+                do {
+                    digits[count++] = static_cast<char>('0' + magnitude % 10);
+                    magnitude /= 10;
+                } while (magnitude);
+
+                while (count) {
+                    out[length++] = digits[--count];
+                }
+            }
+        }
+    }
+
+    // Joins string literals, characters, bools, integers and (GCC/Clang) obfuscated strings into one
+    // obfuscxx<char, N> at compile time, so reading the result is a single bulk decrypt. N reserves the
+    // widest rendering of every integer type and pads the rest with terminators, so size() is that
+    // capacity, not the string length: obf_concat("v", 7).size() is 13. Use the obfusc macro for
+    // per-site entropy
+    template<obf_level Level = obf_level::Low, std::uint64_t Entropy = OBFUSCXX_ENTROPY, class... Parts>
+    consteval auto obf_concat(const Parts &...parts) {
+        constexpr std::size_t capacity = (detail::concat_capacity<Parts>() + ... + 1);
+
+        char text[capacity]{};
+        std::size_t length = 0;
+        (detail::concat_append(text, length, parts), ...);
+
+        return obfuscxx<char, capacity, Level, Entropy>(text);
+    }
+
+#if defined(__clang__) || defined(__GNUC__)
+    // Compile-time concatenation of two obfuscated strings, re-encrypted under a key derived from both.
+    // Operands are obfuscxx instances; "a"_obf + "b"_obf cannot work, operator""_obf already decrypts
+    template<std::size_t LeftSize, obf_level LeftLevel, std::uint64_t LeftEntropy,
+             std::size_t RightSize, obf_level RightLevel, std::uint64_t RightEntropy>
+    consteval auto operator+(const obfuscxx<char, LeftSize, LeftLevel, LeftEntropy> &lhs,
+                             const obfuscxx<char, RightSize, RightLevel, RightEntropy> &rhs) {
+        constexpr obf_level level = LeftLevel > RightLevel ? LeftLevel : RightLevel;
+        constexpr std::uint64_t entropy = detail::splitmix64(LeftEntropy ^ detail::rol64(RightEntropy, 29));
+        return obf_concat<level, entropy>(lhs, rhs);
+    }
+#endif
+
+#if !defined(_KERNEL_MODE) && !defined(_WIN64_DRIVER)
+    // Decrypts several independent single-value instances in one multi-lane pass instead of N serial
+    // XTEA chains; every lane uses the key schedule and round count of its own instance
+    template<class... Types> class obfuscxx_pack {
+        static_assert((detail::instance_access::packable<Types> && ...), "obfuscxx_pack: only single scalar instances can be packed");
+
+        static constexpr std::size_t count = sizeof...(Types);
+        static constexpr std::size_t lanes = (count + 3) & ~static_cast<std::size_t>(3);
+
+        static consteval std::uint32_t max_rounds() {
+            std::uint32_t rounds = 0;
+            ((rounds = detail::instance_access::rounds<Types> > rounds ? detail::instance_access::rounds<Types> : rounds), ...);
+            return rounds;
+        }
+
+        static consteval detail::lane_schedule<lanes> make_schedule() {
+            detail::lane_schedule<lanes> schedule{};
+            const std::uint32_t *keys[] = { detail::instance_access::keys<Types>... };
+            const std::uint32_t rounds[] = { detail::instance_access::rounds<Types>... };
+
+            for (std::size_t l = 0; l < count; ++l) {
+                for (std::uint32_t r = 0; r < rounds[l]; ++r) {
+                    schedule.keys[r][0][l] = keys[l][r * 2];
+                    schedule.keys[r][1][l] = keys[l][r * 2 + 1];
+                    schedule.masks[r][l] = 0xFFFFFFFF;
+                }
+            }
+
+            return schedule;
+        }
+
+        static constexpr std::uint32_t xtea_rounds = max_rounds();
+        static constexpr detail::lane_schedule<lanes> schedule = make_schedule();
+
+        template<class Obfuscxx> static OBFUSCXX_FORCEINLINE void load(const Obfuscxx &value, std::uint32_t &v0, std::uint32_t &v1) {
+            const std::uint64_t block = detail::instance_access::block(value);
+            v0 = static_cast<std::uint32_t>(block);
+            v1 = static_cast<std::uint32_t>(block >> 32);
+        }
+
+        template<std::size_t... I> static OBFUSCXX_FORCEINLINE std::tuple<typename Types::value_type...> unpack(
+            const std::uint32_t *v0, const std::uint32_t *v1, std::index_sequence<I...>) {
+            return { detail::instance_access::value<Types>((static_cast<std::uint64_t>(v1[I]) << 32) | v0[I])... };
+        }
+
+    public:
+        static OBFUSCXX_FORCEINLINE std::tuple<typename Types::value_type...> get(const Types &...values) {
+            alignas(32) std::uint32_t v0[lanes]{};
+            alignas(32) std::uint32_t v1[lanes]{};
+
+            std::size_t l = 0;
+            ((load(values, v0[l], v1[l]), ++l), ...);
+
+            detail::xtea_decrypt_lanes<lanes, xtea_rounds>(v0, v1, schedule);
+            return unpack(v0, v1, std::index_sequence_for<Types...>{});
+        }
+    };
+
+    template<class... Types> OBFUSCXX_FORCEINLINE std::tuple<typename Types::value_type...> get_all(const Types &...values) {
+        return obfuscxx_pack<Types...>::get(values...);
+    }
+#endif
+
+    // Typed accessor over ciphertext produced at build time by obfuscxx_embed (see cmake/obfuscxx_embed.cmake).
+    // The payload is packed densely into little-endian 64-bit blocks and encrypted with the same key
+    // derivation as obfuscxx<..., Level, Entropy>, so reads go through the regular multi-lane decrypt kernels
+    template<class Type, obf_level Level, std::uint64_t Entropy> class embedded_asset {
+        static_assert(std::is_trivially_copyable_v<Type>, "embedded_asset: element type must be trivially copyable");
+
+        static constexpr detail::xtea_key key = detail::make_xtea_key(Entropy, Level);
+        static constexpr std::uint32_t xtea_rounds = key.rounds;
+        static constexpr detail::xtea_schedule<xtea_rounds> schedule = detail::make_xtea_schedule<xtea_rounds>(key.iv, key.delta);
+
+        static constexpr std::size_t chunk_blocks = 64;
+
+    public:
+        constexpr embedded_asset(const std::uint64_t *blocks, std::size_t size_bytes) : blocks(blocks), bytes(size_bytes) {}
+
+        std::size_t size() const { return bytes / sizeof(Type); }
+        std::size_t size_bytes() const { return bytes; }
+
+        // Decrypts count bytes starting at byte offset into out, a chunk of blocks at a time; the range
+        // is clamped to the asset
+        OBFUSCXX_FORCEINLINE void copy_bytes(void *out, std::size_t count, std::size_t offset) const {
+            if (offset >= bytes) return;
+            if (count > bytes - offset) count = bytes - offset;
+
+            auto *dst = static_cast<unsigned char*>(out);
+            std::uint64_t plain[chunk_blocks];
+
+            while (count) {
+                const std::size_t first = offset / 8;
+                const std::size_t skip = offset % 8;
+                std::size_t n = (skip + count + 7) / 8;
+                if (n > chunk_blocks) n = chunk_blocks;
+
+                const std::uint64_t *in = blocks + first;
+                OBFUSCXX_MEM_BARRIER(in)
+                detail::xtea_decrypt_blocks<xtea_rounds>(in, plain, n, schedule.keys);
+
+                std::size_t take = n * 8 - skip;
+                if (take > count) take = count;
+
+                const auto *src = reinterpret_cast<const unsigned char*>(plain) + skip;
+                for (std::size_t b = 0; b < take; ++b) {
+                    dst[b] = src[b];
+                }
+
+                dst += take;
+                offset += take;
+                count -= take;
+            }
+        }
+
+        OBFUSCXX_FORCEINLINE void copy_to(Type *out, std::size_t count, std::size_t index = 0) const {
+            copy_bytes(out, count * sizeof(Type), index * sizeof(Type));
+        }
+
+        OBFUSCXX_FORCEINLINE Type get(std::size_t i) const {
+            struct { unsigned char bytes[sizeof(Type)]; } raw;
+            copy_bytes(raw.bytes, sizeof(Type), i * sizeof(Type));
+            return std::bit_cast<Type>(raw);
+        }
+
+        OBFUSCXX_FORCEINLINE Type operator[](std::size_t i) const {
+            return get(i);
+        }
+
+    private:
+        const std::uint64_t *blocks;
+        std::size_t bytes;
     };
 }
 
 #if defined(__clang__) || defined(__GNUC__)
 template<typename CharType, CharType... chars> constexpr auto operator""_obf() {
     constexpr CharType str[] = {chars..., '\0'};
-    return obfuscxx(str).to_string();
+    return ngu::obfuscxx(str).to_string();
 }
 #endif
 
 #define obfusv(val) obfuscxx(val).get()
 #define obfuss(str) obfuscxx(str).to_string().c_str()
+#define obfusc(...) (obf_concat<obf_level::Low, OBFUSCXX_ENTROPY>(__VA_ARGS__).to_string().c_str())
 
 #endif // NGU_OBFUSCXX_H
\ No newline at end of file
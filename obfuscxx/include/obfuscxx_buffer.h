@@ -0,0 +1,302 @@
+// obfuscxx – runtime-sized obfuscated buffers
+// SPDX-FileCopyrightText: 2025-2026 Alexander (nevergiveup-c)
+// SPDX-License-Identifier: MIT
+
+#ifndef NGU_OBFUSCXX_BUFFER_H
+#define NGU_OBFUSCXX_BUFFER_H
+
+#include "obfuscxx.h"
+
+#if defined(_KERNEL_MODE) || defined(_WIN64_DRIVER)
+#error obfuscxx_buffer.h is not available in kernel mode
+#endif
+
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace ngu {
+    namespace detail {
+        // Allocator handing out Alignment-aligned storage, so ciphertext chunks start on a cache line
+        template<class T, std::size_t Alignment = 64> struct aligned_allocator {
+            using value_type = T;
+
+            template<class U> struct rebind {
+                using other = aligned_allocator<U, Alignment>;
+            };
+
+            aligned_allocator() = default;
+            template<class U> constexpr aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
+            T *allocate(std::size_t n) {
+                return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ Alignment }));
+            }
+
+            void deallocate(T *p, std::size_t) noexcept {
+                ::operator delete(p, std::align_val_t{ Alignment });
+            }
+
+            template<class U> bool operator==(const aligned_allocator<U, Alignment>&) const noexcept {
+                return true;
+            }
+        };
+
+        // Per-instance key nonce: one random_device draw per thread, then a splitmix64 sequence
+        inline std::uint64_t runtime_nonce() {
+            thread_local std::uint64_t state = [] {
+                std::random_device device;
+                return (static_cast<std::uint64_t>(device()) << 32) ^ device();
+            }();
+
+            state += 0x9e3779b97f4a7c15ULL;
+            return splitmix64(state);
+        }
+    }
+
+    // Runtime-sized buffer of trivially-copyable elements for data that only exists at runtime (tokens,
+    // decoded config, fetched keys). Elements are packed little-endian into 64-bit blocks like
+    // embedded_asset, encrypted under a key derived from Entropy and a per-instance runtime nonce.
+    // append/resize only encrypt the new blocks and the partially filled tail block; growing moves the
+    // ciphertext as is. Move-only, plaintext only lives in stack chunks that are wiped after use
+    template<class Type, obf_level Level = obf_level::Medium, std::uint64_t Entropy = OBFUSCXX_ENTROPY,
+             class Allocator = detail::aligned_allocator<std::uint64_t>>
+    class obfuscxx_buffer {
+        static_assert(std::is_trivially_copyable_v<Type>, "obfuscxx_buffer: element type must be trivially copyable");
+
+        using block_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::uint64_t>;
+        using block_traits = std::allocator_traits<block_allocator>;
+
+        // Runtime keys have no per-instance round count, High uses the top of its compile-time range
+        static constexpr std::uint32_t rounds =
+            (Level == obf_level::Low) ? 2 : (Level == obf_level::Medium) ? 6 : detail::xtea_max_rounds;
+
+        static constexpr std::size_t chunk_blocks = 64;
+
+    public:
+        using value_type = Type;
+        using allocator_type = Allocator;
+
+        obfuscxx_buffer() : obfuscxx_buffer(Allocator{}) {}
+
+        explicit obfuscxx_buffer(const Allocator &allocator) : allocator(allocator) {
+            const detail::xtea_key key = detail::make_xtea_key(detail::splitmix64(Entropy ^ detail::runtime_nonce()), Level);
+            detail::fill_xtea_keys(key.iv, key.delta, rounds, keys);
+        }
+
+        explicit obfuscxx_buffer(std::span<const Type> values, const Allocator &allocator = Allocator{})
+            : obfuscxx_buffer(allocator) {
+            append(values);
+        }
+
+        obfuscxx_buffer(const obfuscxx_buffer&) = delete;
+        obfuscxx_buffer &operator=(const obfuscxx_buffer&) = delete;
+
+        obfuscxx_buffer(obfuscxx_buffer &&other) noexcept
+            : allocator(std::move(other.allocator)), blocks(std::exchange(other.blocks, nullptr)),
+              capacity_blocks(std::exchange(other.capacity_blocks, 0)), bytes(std::exchange(other.bytes, 0)) {
+            std::memcpy(keys, other.keys, sizeof(keys));
+        }
+
+        obfuscxx_buffer &operator=(obfuscxx_buffer &&other) noexcept {
+            if (this != &other) {
+                release();
+                allocator = std::move(other.allocator);
+                blocks = std::exchange(other.blocks, nullptr);
+                capacity_blocks = std::exchange(other.capacity_blocks, 0);
+                bytes = std::exchange(other.bytes, 0);
+                std::memcpy(keys, other.keys, sizeof(keys));
+            }
+            return *this;
+        }
+
+        ~obfuscxx_buffer() {
+            release();
+        }
+
+        std::size_t size() const { return bytes / sizeof(Type); }
+        std::size_t size_bytes() const { return bytes; }
+        bool empty() const { return bytes == 0; }
+        std::size_t capacity() const { return capacity_blocks * 8 / sizeof(Type); }
+
+        allocator_type get_allocator() const { return allocator_type(allocator); }
+
+        // Ciphertext of the used blocks, e.g. for persisting the buffer
+        std::span<const std::uint64_t> ciphertext() const { return { blocks, block_count(bytes) }; }
+
+        void reserve(std::size_t count) {
+            grow(block_count(count * sizeof(Type)));
+        }
+
+        void append(std::span<const Type> values) {
+            write_bytes(bytes, values.data(), values.size_bytes());
+        }
+
+        void push_back(const Type &value) {
+            write_bytes(bytes, &value, sizeof(Type));
+        }
+
+        void assign(std::span<const Type> values) {
+            bytes = 0;
+            append(values);
+        }
+
+        // New elements are zero; shrinking re-encrypts only the tail block to clear the cut-off bytes
+        void resize(std::size_t count) {
+            const std::size_t target = count * sizeof(Type);
+            if (target > bytes) {
+                write_bytes(bytes, nullptr, target - bytes);
+            } else if (target < bytes) {
+                bytes = target;
+                if (target % 8) {
+                    write_bytes(target, nullptr, 8 - target % 8);
+                    bytes = target;
+                }
+            }
+        }
+
+        void clear() {
+            bytes = 0;
+        }
+
+        // Setting past the end grows the buffer, the elements in between are zero
+        void set(std::size_t i, const Type &value) {
+            write_bytes(i * sizeof(Type), &value, sizeof(Type));
+        }
+
+        OBFUSCXX_FORCEINLINE Type get(std::size_t i) const {
+            struct { unsigned char bytes[sizeof(Type)]; } raw{};
+            read_bytes(raw.bytes, sizeof(Type), i * sizeof(Type));
+            return std::bit_cast<Type>(raw);
+        }
+
+        OBFUSCXX_FORCEINLINE Type operator[](std::size_t i) const {
+            return get(i);
+        }
+
+        // Decrypts count elements starting at index, a chunk of blocks at a time; clamped to size()
+        OBFUSCXX_FORCEINLINE void copy_to(Type *out, std::size_t count, std::size_t index = 0) const {
+            read_bytes(out, count * sizeof(Type), index * sizeof(Type));
+        }
+
+    private:
+        static constexpr std::size_t block_count(std::size_t byte_count) {
+            return (byte_count + 7) / 8;
+        }
+
+        void grow(std::size_t needed) {
+            if (needed <= capacity_blocks) return;
+
+            std::size_t target = capacity_blocks * 2;
+            if (target < needed) target = needed;
+
+            std::uint64_t *grown = block_traits::allocate(allocator, target);
+            if (blocks) {
+                std::memcpy(grown, blocks, block_count(bytes) * sizeof(std::uint64_t));
+                block_traits::deallocate(allocator, blocks, capacity_blocks);
+            }
+            blocks = grown;
+            capacity_blocks = target;
+        }
+
+        void release() {
+            if (blocks) {
+                block_traits::deallocate(allocator, blocks, capacity_blocks);
+                blocks = nullptr;
+            }
+            capacity_blocks = 0;
+            bytes = 0;
+        }
+
+        // Writes count plaintext bytes (zeros when src is null) at byte offset, growing the buffer when the
+        // range ends past it. A gap between the old end and offset is zero-filled first. Only blocks
+        // partially covered by the range and holding existing data are decrypted first; bytes past the
+        // end always stay zero
+        void write_bytes(std::size_t offset, const void *src, std::size_t count) {
+            if (!count) return;
+            if (offset > bytes) write_bytes(bytes, nullptr, offset - bytes);
+
+            const std::size_t end = offset + count;
+            const std::size_t existing = block_count(bytes);
+            grow(block_count(end));
+
+            const auto *from = static_cast<const unsigned char*>(src);
+            std::uint64_t plain[chunk_blocks];
+
+            for (std::size_t first = offset / 8; first * 8 < end;) {
+                std::size_t n = block_count(end) - first;
+                if (n > chunk_blocks) n = chunk_blocks;
+
+                const std::size_t chunk_begin = first * 8;
+                const std::size_t chunk_end = chunk_begin + n * 8;
+                const std::size_t write_begin = offset > chunk_begin ? offset : chunk_begin;
+                const std::size_t write_end = end < chunk_end ? end : chunk_end;
+
+                std::memset(plain, 0, n * 8);
+                if (write_begin % 8 && first < existing) {
+                    detail::xtea_decrypt_blocks<rounds>(blocks + first, plain, 1, keys);
+                }
+                const std::size_t last = first + n - 1;
+                if (write_end % 8 && last < existing && (last != first || write_begin % 8 == 0)) {
+                    detail::xtea_decrypt_blocks<rounds>(blocks + last, plain + n - 1, 1, keys);
+                }
+
+                auto *dst = reinterpret_cast<unsigned char*>(plain) + (write_begin - chunk_begin);
+                if (from) {
+                    std::memcpy(dst, from + (write_begin - offset), write_end - write_begin);
+                } else {
+                    std::memset(dst, 0, write_end - write_begin);
+                }
+
+                detail::xtea_encrypt_blocks<rounds>(plain, blocks + first, n, keys);
+                first += n;
+            }
+
+            detail::wipe(plain, sizeof(plain));
+            if (end > bytes) bytes = end;
+        }
+
+        // Reads at most the bytes between offset and the end
+        void read_bytes(void *out, std::size_t count, std::size_t offset) const {
+            if (offset >= bytes) return;
+            if (count > bytes - offset) count = bytes - offset;
+
+            auto *dst = static_cast<unsigned char*>(out);
+            std::uint64_t plain[chunk_blocks];
+
+            while (count) {
+                const std::size_t first = offset / 8;
+                const std::size_t skip = offset % 8;
+                std::size_t n = (skip + count + 7) / 8;
+                if (n > chunk_blocks) n = chunk_blocks;
+
+                const std::uint64_t *in = blocks + first;
+                OBFUSCXX_MEM_BARRIER(in)
+                detail::xtea_decrypt_blocks<rounds>(in, plain, n, keys);
+
+                std::size_t take = n * 8 - skip;
+                if (take > count) take = count;
+                std::memcpy(dst, reinterpret_cast<const unsigned char*>(plain) + skip, take);
+
+                dst += take;
+                offset += take;
+                count -= take;
+            }
+
+            detail::wipe(plain, sizeof(plain));
+        }
+
+        [[no_unique_address]] block_allocator allocator;
+        std::uint64_t *blocks{};
+        std::size_t capacity_blocks{};
+        std::size_t bytes{};
+        std::uint32_t keys[rounds * 2]{};
+    };
+}
+
+#endif
@@ -0,0 +1,285 @@
+// obfuscxx – obfuscated function-pointer dispatch tables
+// SPDX-FileCopyrightText: 2025-2026 Alexander (nevergiveup-c)
+// SPDX-License-Identifier: MIT
+
+#ifndef NGU_OBFUSCXX_DISPATCH_H
+#define NGU_OBFUSCXX_DISPATCH_H
+
+#include "obfuscxx.h"
+
+#if defined(_KERNEL_MODE) || defined(_WIN64_DRIVER)
+#error obfuscxx_dispatch.h is not available in kernel mode
+#endif
+
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32)
+// Keep <windows.h> from defining min/max and pulling in the rarely used APIs for every includer
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#define NGU_OBFUSCXX_DISPATCH_LEAN_AND_MEAN
+#endif
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#define NGU_OBFUSCXX_DISPATCH_NOMINMAX
+#endif
+#include <windows.h>
+#if defined(NGU_OBFUSCXX_DISPATCH_LEAN_AND_MEAN)
+#undef WIN32_LEAN_AND_MEAN
+#undef NGU_OBFUSCXX_DISPATCH_LEAN_AND_MEAN
+#endif
+#if defined(NGU_OBFUSCXX_DISPATCH_NOMINMAX)
+#undef NOMINMAX
+#undef NGU_OBFUSCXX_DISPATCH_NOMINMAX
+#endif
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace ngu {
+    enum class dispatch_mode {
+        per_call,   // ciphertext only, every call decrypts its entry
+        decrypted   // decrypted once into a read-only page between two guard pages
+    };
+
+    namespace detail {
+        template<class Method> struct member_thunk_traits;
+
+        template<class R, class Class, class... Args> struct member_thunk_traits<R (Class::*)(Args...)> {
+            template<auto Method> static R call(Class &self, Args... args) {
+                return (self.*Method)(std::forward<Args>(args)...);
+            }
+        };
+
+        template<class R, class Class, class... Args> struct member_thunk_traits<R (Class::*)(Args...) const> {
+            template<auto Method> static R call(const Class &self, Args... args) {
+                return (self.*Method)(std::forward<Args>(args)...);
+            }
+        };
+
+        // [guard page][table pages][guard page], the table ends right at the trailing guard page
+        class guarded_pages {
+        public:
+            guarded_pages() = default;
+            guarded_pages(const guarded_pages&) = delete;
+            guarded_pages &operator=(const guarded_pages&) = delete;
+
+            guarded_pages(guarded_pages &&other) noexcept
+                : base(std::exchange(other.base, nullptr)), total(std::exchange(other.total, 0)),
+                  table(std::exchange(other.table, nullptr)) {}
+
+            guarded_pages &operator=(guarded_pages &&other) noexcept {
+                if (this != &other) {
+                    release();
+                    base = std::exchange(other.base, nullptr);
+                    total = std::exchange(other.total, 0);
+                    table = std::exchange(other.table, nullptr);
+                }
+                return *this;
+            }
+
+            ~guarded_pages() { release(); }
+
+            // Returns a writable region of bytes, or nullptr when the pages cannot be mapped
+            void *allocate(std::size_t bytes) {
+                release();
+
+                const std::size_t page = page_size();
+                const std::size_t body = (bytes + page - 1) / page * page;
+                total = body + 2 * page;
+
+#if defined(_WIN32)
+                base = static_cast<unsigned char*>(VirtualAlloc(nullptr, total, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+                DWORD old;
+                if (base && (!VirtualProtect(base, page, PAGE_NOACCESS, &old) ||
+                             !VirtualProtect(base + page + body, page, PAGE_NOACCESS, &old))) {
+                    release();
+                }
+#else
+                void *mapping = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                base = mapping == MAP_FAILED ? nullptr : static_cast<unsigned char*>(mapping);
+                if (base && (mprotect(base, page, PROT_NONE) != 0 ||
+                             mprotect(base + page + body, page, PROT_NONE) != 0)) {
+                    release();
+                }
+#endif
+                if (!base) {
+                    total = 0;
+                    return nullptr;
+                }
+
+                table = base + page + body - bytes;
+                return table;
+            }
+
+            bool protect(bool read_only) {
+                if (!base) return false;
+
+                const std::size_t page = page_size();
+#if defined(_WIN32)
+                DWORD old;
+                return VirtualProtect(base + page, total - 2 * page, read_only ? PAGE_READONLY : PAGE_READWRITE, &old) != 0;
+#else
+                return mprotect(base + page, total - 2 * page, read_only ? PROT_READ : PROT_READ | PROT_WRITE) == 0;
+#endif
+            }
+
+            void *get() const { return table; }
+
+        private:
+            static std::size_t page_size() {
+#if defined(_WIN32)
+                SYSTEM_INFO info;
+                GetSystemInfo(&info);
+                return info.dwPageSize;
+#else
+                return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+            }
+
+            void release() {
+                if (!base) return;
+#if defined(_WIN32)
+                VirtualFree(base, 0, MEM_RELEASE);
+#else
+                munmap(base, total);
+#endif
+                base = nullptr;
+                total = 0;
+                table = nullptr;
+            }
+
+            unsigned char *base{};
+            std::size_t total{};
+            void *table{};
+        };
+    }
+
+    // Plain function pointer calling a member function, e.g. member_thunk<&widget::run> has the
+    // type R (*)(widget&, Args...) and can be stored in a dispatch table
+    template<auto Method> inline constexpr auto member_thunk =
+        &detail::member_thunk_traits<decltype(Method)>::template call<Method>;
+
+    // Fixed-size table of Fn* entries. per_call keeps only ciphertext and decrypts one entry per call;
+    // Low is the default level because the decrypt sits on the call path. decrypted runs one multi-lane
+    // decrypt at construction into a read-only guarded page and falls back to per_call when the pages
+    // cannot be mapped. Function addresses only exist at runtime, so entries are always encrypted at runtime
+    // and OBFUSCXX_RUNTIME_BULK_WARNING does not apply
+    template<class Fn, std::size_t Size, dispatch_mode Mode = dispatch_mode::per_call,
+             obf_level Level = obf_level::Low, std::uint64_t Entropy = OBFUSCXX_ENTROPY>
+    class obfuscated_dispatch_table {
+        static_assert(std::is_function_v<Fn>, "obfuscated_dispatch_table: Fn must be a function type, e.g. int(int)");
+        static_assert(Size > 0, "obfuscated_dispatch_table: Size must be positive");
+
+        // obfuscxx<T, 1> is a single value without indexed access, one-entry tables keep a spare slot
+        static constexpr std::size_t storage_size = Size > 1 ? Size : 2;
+
+    public:
+        using function_type = Fn;
+        using pointer = Fn*;
+        using storage_type = obfuscxx<Fn*, storage_size, Level, Entropy>;
+
+        obfuscated_dispatch_table(std::initializer_list<Fn*> entries)
+            : obfuscated_dispatch_table(std::span<Fn* const>{ entries.begin(), entries.size() }) {}
+
+        explicit obfuscated_dispatch_table(std::span<Fn* const> entries) {
+            detail::instance_access::assign(encrypted, 0, entries.first(entries.size() < Size ? entries.size() : Size));
+            materialize();
+        }
+
+        // Takes over entries of an existing obfuscxx<Fn*, Size> table with one multi-lane decrypt; a single
+        // obfuscxx<Fn*, 1> has no indexed access, so one-entry tables take the pointer instead
+        template<obf_level OtherLevel, std::uint64_t OtherEntropy>
+        explicit obfuscated_dispatch_table(const obfuscxx<Fn*, Size, OtherLevel, OtherEntropy> &entries) requires (Size > 1) {
+            Fn *plain_entries[Size];
+            entries.copy_to(plain_entries, Size);
+
+            detail::instance_access::assign(encrypted, 0, std::span<Fn* const>{ plain_entries, Size });
+            detail::wipe(plain_entries, sizeof(plain_entries));
+            materialize();
+        }
+
+        obfuscated_dispatch_table(const obfuscated_dispatch_table&) = delete;
+        obfuscated_dispatch_table &operator=(const obfuscated_dispatch_table&) = delete;
+
+        obfuscated_dispatch_table(obfuscated_dispatch_table &&other) noexcept
+            : encrypted(other.encrypted), pages(std::move(other.pages)), plain(std::exchange(other.plain, nullptr)) {}
+
+        obfuscated_dispatch_table &operator=(obfuscated_dispatch_table &&other) noexcept {
+            if (this != &other) {
+                encrypted = other.encrypted;
+                pages = std::move(other.pages);
+                plain = std::exchange(other.plain, nullptr);
+            }
+            return *this;
+        }
+
+        OBFUSCXX_FORCEINLINE Fn *get(std::size_t i) const {
+            if constexpr (Mode == dispatch_mode::decrypted) {
+                if (plain) return plain[i];
+            }
+            return encrypted.get(i);
+        }
+
+        template<class... Args> OBFUSCXX_FORCEINLINE decltype(auto) operator()(std::size_t i, Args &&...args) const {
+            return get(i)(std::forward<Args>(args)...);
+        }
+
+        OBFUSCXX_FORCEINLINE Fn *operator[](std::size_t i) const {
+            return get(i);
+        }
+
+        // Replaces one entry; the decrypted table is made writable only for the store. When the page
+        // protection cannot be changed either way the table drops to per_call, so get() never serves a
+        // stale entry and is_protected() never reports a writable table
+        void set(std::size_t i, Fn *fn) {
+            detail::instance_access::assign(encrypted, i, std::span<Fn* const>{ &fn, 1 });
+
+            if constexpr (Mode == dispatch_mode::decrypted) {
+                if (!plain) return;
+
+                if (pages.protect(false)) {
+                    const_cast<Fn**>(plain)[i] = fn;
+                    if (pages.protect(true)) return;
+                }
+                pages = detail::guarded_pages{};
+                plain = nullptr;
+            }
+        }
+
+        // True when calls are served from the read-only plaintext table
+        bool is_protected() const {
+            return plain != nullptr;
+        }
+
+        static constexpr std::size_t size() {
+            return Size;
+        }
+
+    private:
+        void materialize() {
+            if constexpr (Mode == dispatch_mode::decrypted) {
+                auto *table = static_cast<Fn**>(pages.allocate(sizeof(Fn*) * Size));
+                if (!table) return;
+
+                encrypted.copy_to(table, Size);
+                if (pages.protect(true)) {
+                    plain = table;
+                } else {
+                    pages = detail::guarded_pages{};
+                }
+            }
+        }
+
+        storage_type encrypted{};
+        detail::guarded_pages pages;
+        Fn *const *plain{};
+    };
+}
+
+#endif
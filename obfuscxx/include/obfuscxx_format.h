@@ -0,0 +1,155 @@
+// obfuscxx – std::format support for obfuscated strings
+// SPDX-FileCopyrightText: 2025-2026 Alexander (nevergiveup-c)
+// SPDX-License-Identifier: MIT
+
+#ifndef NGU_OBFUSCXX_FORMAT_H
+#define NGU_OBFUSCXX_FORMAT_H
+
+#include "obfuscxx.h"
+
+#if defined(_KERNEL_MODE) || defined(_WIN64_DRIVER)
+#error obfuscxx_format.h is not available in kernel mode
+#endif
+
+#include <cstddef>
+#include <type_traits>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#include <format>
+
+namespace ngu::detail {
+    // Parsed string format spec: [[fill]align][width][.precision][s]. Width and precision are either
+    // literal or taken from an argument ({} / {n}); width counts code units, the fill is one code unit
+    template<class CharType> struct string_format_spec {
+        static constexpr std::size_t none = ~std::size_t{};
+
+        CharType fill{ ' ' };
+        CharType align{ '<' };
+        std::size_t width{};
+        std::size_t width_arg{ none };
+        std::size_t precision{ none };
+        std::size_t precision_arg{ none };
+
+        template<class ParseContext> constexpr auto parse(ParseContext &ctx) {
+            auto it = ctx.begin();
+            const auto end = ctx.end();
+
+            const auto is_align = [](CharType c) { return c == '<' || c == '>' || c == '^'; };
+            if (it != end && it + 1 != end && is_align(it[1]) && *it != '{' && *it != '}') {
+                fill = *it;
+                align = it[1];
+                it += 2;
+            } else if (it != end && is_align(*it)) {
+                align = *it++;
+            }
+
+            if (it != end && *it >= '1' && *it <= '9') {
+                it = parse_number(it, end, width);
+            } else if (it != end && *it == '{') {
+                it = parse_arg_id(ctx, it + 1, end, width_arg);
+            }
+
+            if (it != end && *it == '.') {
+                ++it;
+                if (it != end && *it >= '0' && *it <= '9') {
+                    it = parse_number(it, end, precision);
+                } else if (it != end && *it == '{') {
+                    it = parse_arg_id(ctx, it + 1, end, precision_arg);
+                } else {
+                    throw std::format_error("obfuscxx: missing precision");
+                }
+            }
+
+            if (it != end && *it == 's') ++it;
+            if (it != end && *it != '}') throw std::format_error("obfuscxx: invalid format spec for a string");
+            return it;
+        }
+
+        // Resolves argument-provided width and precision against the format arguments
+        template<class FormatContext> void resolve(FormatContext &ctx, std::size_t &out_width, std::size_t &out_precision) const {
+            out_width = width_arg == none ? width : arg_value(ctx, width_arg);
+            out_precision = precision_arg == none ? precision : arg_value(ctx, precision_arg);
+        }
+
+    private:
+        template<class Iterator> static constexpr Iterator parse_number(Iterator it, Iterator end, std::size_t &value) {
+            value = 0;
+            for (; it != end && *it >= '0' && *it <= '9'; ++it) {
+                value = value * 10 + static_cast<std::size_t>(*it - '0');
+            }
+            return it;
+        }
+
+        template<class ParseContext, class Iterator>
+        static constexpr Iterator parse_arg_id(ParseContext &ctx, Iterator it, Iterator end, std::size_t &id) {
+            if (it != end && *it == '}') {
+                id = ctx.next_arg_id();
+            } else {
+                it = parse_number(it, end, id);
+                ctx.check_arg_id(id);
+            }
+            if (it == end || *it != '}') throw std::format_error("obfuscxx: invalid argument id in format spec");
+            return it + 1;
+        }
+
+        template<class FormatContext> static std::size_t arg_value(FormatContext &ctx, std::size_t id) {
+            return std::visit_format_arg([](auto value) -> std::size_t {
+                using Value = decltype(value);
+                if constexpr (std::is_integral_v<Value> && !std::is_same_v<Value, bool> && !std::is_same_v<Value, CharType>) {
+                    if (value < 0) throw std::format_error("obfuscxx: negative width or precision");
+                    return static_cast<std::size_t>(value);
+                } else {
+                    throw std::format_error("obfuscxx: width or precision argument is not an integer");
+                }
+            }, ctx.arg(id));
+        }
+    };
+}
+
+// Writes the decrypted chunks straight to the format output iterator. A width needs the length first,
+// so it takes one counting pass like operator<<; no full plaintext copy is built either way
+template<class CharType, std::size_t Size, ngu::obf_level Level, std::uint64_t Entropy>
+    requires (std::is_same_v<CharType, char> || std::is_same_v<CharType, wchar_t>)
+struct std::formatter<ngu::obfuscxx<CharType, Size, Level, Entropy>, CharType> {
+    template<class ParseContext> constexpr auto parse(ParseContext &ctx) {
+        return spec.parse(ctx);
+    }
+
+    template<class FormatContext> auto format(const ngu::obfuscxx<CharType, Size, Level, Entropy> &str, FormatContext &ctx) const {
+        std::size_t width, precision;
+        spec.resolve(ctx, width, precision);
+
+        auto out = ctx.out();
+        const auto emit = [&out, &str](std::size_t limit) {
+            str.for_each_chunk([&out, &limit](const CharType *chunk, std::size_t n) {
+                for (std::size_t i = 0; i < n && limit; ++i, --limit) {
+                    *out++ = chunk[i];
+                }
+            });
+        };
+
+        if (!width) {
+            emit(precision);
+            return out;
+        }
+
+        std::size_t length = 0;
+        str.for_each_chunk([&length](const CharType*, std::size_t n) { length += n; });
+        if (length > precision) length = precision;
+
+        const std::size_t pad = width > length ? width - length : 0;
+        const std::size_t before = spec.align == '>' ? pad : spec.align == '^' ? pad / 2 : 0;
+
+        for (std::size_t i = 0; i < before; ++i) *out++ = spec.fill;
+        emit(length);
+        for (std::size_t i = before; i < pad; ++i) *out++ = spec.fill;
+        return out;
+    }
+
+private:
+    ngu::detail::string_format_spec<CharType> spec;
+};
+#endif
+
+#endif
@@ -0,0 +1,22 @@
+// obfuscxx – lean include without the intrinsic headers
+// SPDX-FileCopyrightText: 2025-2026 Alexander (nevergiveup-c)
+// SPDX-License-Identifier: MIT
+//
+// Same types and consteval encryption as obfuscxx.h; decryption runs in the kernels of the obfuscxx_lean
+// library (src/obfuscxx_kernels.cpp), which has to be linked. Must be included before anything else
+// that includes obfuscxx.h, and load_decrypted() is not available.
+
+#ifndef NGU_OBFUSCXX_LEAN_H
+#define NGU_OBFUSCXX_LEAN_H
+
+#if defined(NGU_OBFUSCXX_H) && !defined(OBFUSCXX_LEAN)
+#error obfuscxx_lean.h must be included before obfuscxx.h
+#endif
+
+#ifndef OBFUSCXX_LEAN
+#define OBFUSCXX_LEAN
+#endif
+
+#include "obfuscxx.h"
+
+#endif
@@ -0,0 +1,320 @@
+// obfuscxx – runtime-keyed arrays with incremental key rotation
+// SPDX-FileCopyrightText: 2025-2026 Alexander (nevergiveup-c)
+// SPDX-License-Identifier: MIT
+
+#ifndef NGU_OBFUSCXX_ROTATING_H
+#define NGU_OBFUSCXX_ROTATING_H
+
+#include "obfuscxx.h"
+
+#if defined(_KERNEL_MODE) || defined(_WIN64_DRIVER)
+#error obfuscxx_rotating.h is not available in kernel mode
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <random>
+#include <span>
+#include <stop_token>
+#include <thread>
+
+namespace ngu {
+    // Runtime-keyed array of Size scalars that can move to a fresh key without one long stall. The
+    // data is split into chunks of ChunkSize elements; every chunk carries the key generation it is
+    // encrypted under and a sequence counter. Rotation re-encrypts a bounded number of chunks per
+    // slice, writers are serialized by a mutex, and readers never lock: they read a chunk's
+    // generation, ciphertext and key, then retry only if that chunk's sequence moved meanwhile
+    template<class Type, std::size_t Size, obf_level Level = obf_level::Medium, std::size_t ChunkSize = 64>
+    class obfuscxx_rotating {
+        static_assert(std::is_arithmetic_v<Type> || std::is_enum_v<Type> || std::is_pointer_v<Type>,
+            "obfuscxx_rotating: only scalar types are supported");
+        static_assert(sizeof(Type) <= 8, "obfuscxx_rotating: type must fit in a 64-bit block");
+        static_assert(Size > 0 && ChunkSize > 0, "obfuscxx_rotating: Size and ChunkSize must be positive");
+
+        // Runtime keys have no per-instance round count, High uses the top of its compile-time range
+        static constexpr std::uint32_t rounds =
+            (Level == obf_level::Low) ? 2 : (Level == obf_level::Medium) ? 6 : detail::xtea_max_rounds;
+
+        static constexpr std::size_t chunk_count = (Size + ChunkSize - 1) / ChunkSize;
+
+        // Slot g & 1 holds the keys of generation g; the slot of g + 1 is only rewritten once no chunk
+        // is left on g - 1, and a reader racing with that rewrite fails its sequence check
+        struct key_slot {
+            std::atomic<std::uint32_t> keys[rounds * 2];
+        };
+
+        struct chunk_state {
+            std::atomic<std::uint32_t> sequence{};   // odd while the chunk is being rewritten
+            std::atomic<std::uint32_t> generation{};
+        };
+
+    public:
+        using value_type = Type;
+
+        obfuscxx_rotating() {
+            rekey(slots[0]);
+
+            std::uint32_t keys[rounds * 2];
+            load_keys(0, keys);
+            const std::uint64_t zero = detail::xtea_encrypt_block(detail::to_block(Type{}), keys, rounds);
+            for (auto &block : data) block.store(zero, std::memory_order_relaxed);
+            detail::wipe(keys, sizeof(keys));
+        }
+
+        explicit obfuscxx_rotating(std::span<const Type> values) : obfuscxx_rotating() {
+            assign(values);
+        }
+
+        obfuscxx_rotating(const obfuscxx_rotating&) = delete;
+        obfuscxx_rotating &operator=(const obfuscxx_rotating&) = delete;
+
+        ~obfuscxx_rotating() {
+            stop_background_rotation();
+        }
+
+        Type get(std::size_t i) const {
+            const auto &chunk = chunks[i / ChunkSize];
+            std::uint32_t keys[rounds * 2];
+
+            for (;;) {
+                const std::uint32_t sequence = chunk.sequence.load(std::memory_order_acquire);
+                if (sequence & 1) continue;
+
+                const std::uint64_t block = data[i].load(std::memory_order_relaxed);
+                load_keys(chunk.generation.load(std::memory_order_relaxed), keys);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (chunk.sequence.load(std::memory_order_relaxed) == sequence) {
+                    const Type value = detail::from_block<Type>(detail::xtea_decrypt_block(block, keys, rounds));
+                    detail::wipe(keys, sizeof(keys));
+                    return value;
+                }
+            }
+        }
+
+        Type operator[](std::size_t i) const {
+            return get(i);
+        }
+
+        void copy_to(Type *out, std::size_t count) const {
+            std::uint64_t cipher[ChunkSize], plain[ChunkSize];
+            std::uint32_t keys[rounds * 2];
+            const std::size_t n = (count < Size) ? count : Size;
+
+            for (std::size_t first = 0; first < n; first += ChunkSize) {
+                const std::size_t length = (n - first < ChunkSize) ? n - first : ChunkSize;
+                const auto &chunk = chunks[first / ChunkSize];
+
+                for (;;) {
+                    const std::uint32_t sequence = chunk.sequence.load(std::memory_order_acquire);
+                    if (sequence & 1) continue;
+
+                    for (std::size_t j = 0; j < length; ++j) {
+                        cipher[j] = data[first + j].load(std::memory_order_relaxed);
+                    }
+                    load_keys(chunk.generation.load(std::memory_order_relaxed), keys);
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (chunk.sequence.load(std::memory_order_relaxed) == sequence) break;
+                }
+
+                detail::xtea_decrypt_blocks<rounds>(cipher, plain, length, keys);
+                for (std::size_t j = 0; j < length; ++j) {
+                    out[first + j] = detail::from_block<Type>(plain[j]);
+                }
+            }
+
+            detail::wipe(plain, sizeof(plain));
+            detail::wipe(keys, sizeof(keys));
+        }
+
+        void set(std::size_t i, Type value) {
+            std::lock_guard lock(writer);
+            auto &chunk = chunks[i / ChunkSize];
+
+            std::uint32_t keys[rounds * 2];
+            load_keys(chunk.generation.load(std::memory_order_relaxed), keys);
+
+            begin_write(chunk);
+            data[i].store(detail::xtea_encrypt_block(detail::to_block(value), keys, rounds), std::memory_order_relaxed);
+            end_write(chunk);
+
+            detail::wipe(keys, sizeof(keys));
+        }
+
+        void assign(std::span<const Type> values) {
+            std::uint64_t plain[ChunkSize], cipher[ChunkSize];
+            std::uint32_t keys[rounds * 2];
+            const std::size_t n = (values.size() < Size) ? values.size() : Size;
+
+            std::lock_guard lock(writer);
+            for (std::size_t first = 0; first < n; first += ChunkSize) {
+                const std::size_t length = (n - first < ChunkSize) ? n - first : ChunkSize;
+                auto &chunk = chunks[first / ChunkSize];
+
+                for (std::size_t j = 0; j < length; ++j) {
+                    plain[j] = detail::to_block(values[first + j]);
+                }
+                load_keys(chunk.generation.load(std::memory_order_relaxed), keys);
+                detail::xtea_encrypt_blocks<rounds>(plain, cipher, length, keys);
+
+                begin_write(chunk);
+                for (std::size_t j = 0; j < length; ++j) {
+                    data[first + j].store(cipher[j], std::memory_order_relaxed);
+                }
+                end_write(chunk);
+            }
+
+            detail::wipe(plain, sizeof(plain));
+            detail::wipe(keys, sizeof(keys));
+        }
+
+        // Draws the next key; returns false while the previous rotation is still in progress
+        bool begin_rotation() {
+            std::lock_guard lock(writer);
+            if (cursor < chunk_count) return false;
+
+            rekey(slots[(current + 1) & 1]);
+            ++current;
+            cursor = 0;
+            return true;
+        }
+
+        // Re-encrypts at most max_chunks chunks under the new key. Writers wait at most one slice and a
+        // reader only retries while the one chunk it reads is rewritten. Returns true once no rotation
+        // is pending
+        bool rotate_step(std::size_t max_chunks = 1) {
+            std::uint64_t block[ChunkSize];
+            std::uint32_t from[rounds * 2], to[rounds * 2];
+
+            std::lock_guard lock(writer);
+            if (cursor >= chunk_count) return true;
+
+            load_keys(current - 1, from);
+            load_keys(current, to);
+
+            for (std::size_t done = 0; done < max_chunks && cursor < chunk_count; ++done, ++cursor) {
+                const std::size_t first = cursor * ChunkSize;
+                const std::size_t length = (Size - first < ChunkSize) ? Size - first : ChunkSize;
+                auto &chunk = chunks[cursor];
+
+                for (std::size_t j = 0; j < length; ++j) {
+                    block[j] = data[first + j].load(std::memory_order_relaxed);
+                }
+                detail::xtea_decrypt_blocks<rounds>(block, block, length, from);
+                detail::xtea_encrypt_blocks<rounds>(block, block, length, to);
+
+                begin_write(chunk);
+                for (std::size_t j = 0; j < length; ++j) {
+                    data[first + j].store(block[j], std::memory_order_relaxed);
+                }
+                chunk.generation.store(current, std::memory_order_relaxed);
+                end_write(chunk);
+            }
+
+            // block held a plaintext chunk between the two passes
+            detail::wipe(block, sizeof(block));
+            detail::wipe(from, sizeof(from));
+            detail::wipe(to, sizeof(to));
+            return cursor >= chunk_count;
+        }
+
+        // Full rotation, still in slices of max_chunks so writers are never held longer than one slice
+        void rotate(std::size_t max_chunks = 1) {
+            while (!begin_rotation()) {
+                rotate_step(max_chunks);
+            }
+            while (!rotate_step(max_chunks)) {}
+        }
+
+        bool rotating() const {
+            std::lock_guard lock(writer);
+            return cursor < chunk_count;
+        }
+
+        std::uint32_t generation() const {
+            std::lock_guard lock(writer);
+            return current;
+        }
+
+        // Rotates every interval on a background thread, yielding between slices of max_chunks chunks
+        void start_background_rotation(std::chrono::milliseconds interval, std::size_t max_chunks = 1) {
+            stop_background_rotation();
+
+            worker = std::jthread([this, interval, max_chunks](std::stop_token stop) {
+                std::mutex wait_mutex;
+                std::condition_variable_any wake;
+
+                while (!stop.stop_requested()) {
+                    begin_rotation();
+                    while (!stop.stop_requested() && !rotate_step(max_chunks)) {
+                        std::this_thread::yield();
+                    }
+
+                    std::unique_lock wait_lock(wait_mutex);
+                    wake.wait_for(wait_lock, stop, interval, [] { return false; });
+                }
+            });
+        }
+
+        void stop_background_rotation() {
+            if (worker.joinable()) {
+                worker.request_stop();
+                worker.join();
+            }
+        }
+
+        static constexpr std::size_t size() {
+            return Size;
+        }
+
+        // Elements per chunk; rotate_step(n) re-encrypts n chunks
+        static constexpr std::size_t chunk_size() {
+            return ChunkSize;
+        }
+
+    private:
+        void load_keys(std::uint32_t generation, std::uint32_t *keys) const {
+            const auto &slot = slots[generation & 1];
+            for (std::uint32_t k = 0; k < rounds * 2; ++k) {
+                keys[k] = slot.keys[k].load(std::memory_order_relaxed);
+            }
+        }
+
+        static void begin_write(chunk_state &chunk) {
+            chunk.sequence.store(chunk.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        static void end_write(chunk_state &chunk) {
+            chunk.sequence.store(chunk.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        static void rekey(key_slot &slot) {
+            std::random_device device;
+            const std::uint64_t seed = detail::splitmix64((static_cast<std::uint64_t>(device()) << 32) ^ device());
+
+            const detail::xtea_key key = detail::make_xtea_key(seed, Level);
+            std::uint32_t keys[rounds * 2];
+            detail::fill_xtea_keys(key.iv, key.delta, rounds, keys);
+            for (std::uint32_t k = 0; k < rounds * 2; ++k) {
+                slot.keys[k].store(keys[k], std::memory_order_relaxed);
+            }
+            detail::wipe(keys, sizeof(keys));
+        }
+
+        std::atomic<std::uint64_t> data[Size]{};
+        chunk_state chunks[chunk_count]{};
+        key_slot slots[2]{};
+
+        mutable std::mutex writer;
+        std::uint32_t current{};
+        std::size_t cursor{ chunk_count };
+        std::jthread worker;
+    };
+}
+
+#endif
@@ -0,0 +1,498 @@
+// obfuscxx – memory-mapped encrypted table files
+// SPDX-FileCopyrightText: 2025-2026 Alexander (nevergiveup-c)
+// SPDX-License-Identifier: MIT
+
+#ifndef NGU_OBFUSCXX_VIEW_H
+#define NGU_OBFUSCXX_VIEW_H
+
+#include "obfuscxx.h"
+
+#if defined(_KERNEL_MODE) || defined(_WIN64_DRIVER)
+#error obfuscxx_view.h is not available in kernel mode
+#endif
+
+#include <bit>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32)
+// Keep <windows.h> from defining min/max and pulling in the rarely used APIs for every includer
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#define NGU_OBFUSCXX_VIEW_LEAN_AND_MEAN
+#endif
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#define NGU_OBFUSCXX_VIEW_NOMINMAX
+#endif
+#include <windows.h>
+#if defined(NGU_OBFUSCXX_VIEW_LEAN_AND_MEAN)
+#undef WIN32_LEAN_AND_MEAN
+#undef NGU_OBFUSCXX_VIEW_LEAN_AND_MEAN
+#endif
+#if defined(NGU_OBFUSCXX_VIEW_NOMINMAX)
+#undef NOMINMAX
+#undef NGU_OBFUSCXX_VIEW_NOMINMAX
+#endif
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ngu {
+    namespace detail {
+        // Table file layout (little-endian): a 64-byte table_header, then count elements of
+        // (element_size + 7) / 8 blocks each in the obfuscxx layout: scalars widened like detail::to_block
+        // (narrow signed integers and enums sign-extended, everything else zero-extended), larger types
+        // packed and zero-padded like obfuscxx objects
+        struct table_header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t level;
+            std::uint32_t rounds;
+            std::uint32_t element_size;
+            std::uint64_t count;
+            std::uint64_t nonce;
+            std::uint64_t check;        // magic ^ nonce under the table key, rejects a wrong seed or level
+            std::uint32_t flags;        // table_sign_extended
+            std::uint32_t reserved[3];
+        };
+        static_assert(sizeof(table_header) == 64, "table_header must stay one cache line");
+
+        inline constexpr char table_magic[8] = { 'N', 'G', 'U', 'O', 'B', 'F', 'T', 'B' };
+        inline constexpr std::uint32_t table_version = 1;
+
+        // Elements narrower than a block were sign-extended into it
+        inline constexpr std::uint32_t table_sign_extended = 1;
+
+        // Whether detail::to_block sign-extends Type, i.e. the flag write_obfuscxx_table<Type> sets
+        template<class Type> constexpr bool table_sign_extends() {
+            if constexpr (sizeof(Type) >= 8) {
+                return false;
+            } else if constexpr (std::is_enum_v<Type>) {
+                return std::is_signed_v<std::underlying_type_t<Type>>;
+            } else {
+                return std::is_integral_v<Type> && std::is_signed_v<Type>;
+            }
+        }
+
+        // Widens one element of size bytes (at most 8) into its plaintext block
+        OBFUSCXX_FORCEINLINE std::uint64_t table_block(const void *element, std::size_t size, bool sign_extend) {
+            std::uint64_t block = 0;
+            std::memcpy(&block, element, size);
+            if (sign_extend && size < 8 && (block >> (size * 8 - 1)) & 1) {
+                block |= ~std::uint64_t{} << (size * 8);
+            }
+            return block;
+        }
+
+        // Table keys are runtime keys (the nonce comes from the file), so rounds are fixed per level
+        constexpr std::uint32_t table_rounds(obf_level level) {
+            return (level == obf_level::Low) ? 2 : (level == obf_level::Medium) ? 6 : xtea_max_rounds;
+        }
+
+        // Key of one table: the seed shared by writer and reader, mixed with the file's nonce
+        inline void table_keys(std::uint64_t seed, std::uint64_t nonce, obf_level level, std::uint32_t *keys) {
+            const xtea_key key = make_xtea_key(splitmix64(seed ^ nonce), level);
+            fill_xtea_keys(key.iv, key.delta, table_rounds(level), keys);
+        }
+
+        inline std::uint64_t table_check(std::uint64_t nonce, const std::uint32_t *keys, std::uint32_t rounds) {
+            std::uint64_t magic;
+            std::memcpy(&magic, table_magic, sizeof(magic));
+            return xtea_encrypt_block(magic ^ nonce, keys, rounds);
+        }
+
+        // Streams elements into a table file: a placeholder header, the ciphertext a chunk at a time,
+        // then the final header once the count is known. Level is a runtime value for the writer tool;
+        // elements are limited to max_element_size bytes
+        class table_writer {
+            static constexpr std::size_t chunk_blocks = 256;
+
+        public:
+            static constexpr std::uint32_t max_element_size = chunk_blocks * 8;
+
+            table_writer(std::FILE *file, std::uint32_t element_size, obf_level level, std::uint64_t seed, std::uint64_t nonce,
+                         bool sign_extend = false)
+                : file(file), stride((element_size + 7) / 8), level(level), sign_extend(sign_extend && element_size < 8) {
+                header.version = table_version;
+                header.flags = this->sign_extend ? table_sign_extended : 0;
+                header.level = static_cast<std::uint32_t>(level);
+                header.rounds = table_rounds(level);
+                header.element_size = element_size;
+                header.nonce = nonce;
+                std::memcpy(header.magic, table_magic, sizeof(header.magic));
+
+                table_keys(seed, nonce, level, keys);
+                header.check = table_check(nonce, keys, header.rounds);
+
+                ok = element_size != 0 && element_size <= max_element_size && std::fwrite(&header, sizeof(header), 1, file) == 1;
+            }
+
+            table_writer(const table_writer&) = delete;
+            table_writer &operator=(const table_writer&) = delete;
+
+            ~table_writer() {
+                wipe(plain, sizeof(plain));
+            }
+
+            // Encrypts and appends count elements of element_size bytes each
+            bool write(const void *elements, std::size_t count) {
+                if (!ok) return false;
+
+                const auto *src = static_cast<const unsigned char*>(elements);
+                const std::size_t per_chunk = chunk_blocks / stride;
+
+                while (ok && count) {
+                    const std::size_t n = count < per_chunk ? count : per_chunk;
+
+                    if (stride == 1) {
+                        for (std::size_t e = 0; e < n; ++e) {
+                            plain[e] = table_block(src + e * header.element_size, header.element_size, sign_extend);
+                        }
+                    } else {
+                        std::memset(plain, 0, n * stride * 8);
+                        for (std::size_t e = 0; e < n; ++e) {
+                            std::memcpy(plain + e * stride, src + e * header.element_size, header.element_size);
+                        }
+                    }
+
+                    encrypt(n * stride);
+                    ok = std::fwrite(cipher, 8, n * stride, file) == n * stride;
+
+                    src += n * header.element_size;
+                    header.count += n;
+                    count -= n;
+                }
+                return ok;
+            }
+
+            // Rewrites the header with the final element count
+            bool finish() {
+                return ok && std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                       std::fflush(file) == 0;
+            }
+
+        private:
+            void encrypt(std::size_t n) {
+                switch (level) {
+                case obf_level::Low: xtea_encrypt_blocks<table_rounds(obf_level::Low)>(plain, cipher, n, keys); break;
+                case obf_level::Medium: xtea_encrypt_blocks<table_rounds(obf_level::Medium)>(plain, cipher, n, keys); break;
+                default: xtea_encrypt_blocks<table_rounds(obf_level::High)>(plain, cipher, n, keys); break;
+                }
+            }
+
+            std::FILE *file;
+            std::size_t stride;
+            obf_level level;
+            bool sign_extend;
+            bool ok{};
+            table_header header{};
+            std::uint32_t keys[xtea_max_rounds * 2]{};
+            std::uint64_t plain[chunk_blocks];
+            std::uint64_t cipher[chunk_blocks];
+        };
+
+        // Read-only shared mapping of a whole file
+        class mapped_file {
+        public:
+            mapped_file() = default;
+            mapped_file(const mapped_file&) = delete;
+            mapped_file &operator=(const mapped_file&) = delete;
+
+            mapped_file(mapped_file &&other) noexcept
+                : base(std::exchange(other.base, nullptr)), length(std::exchange(other.length, 0)) {}
+
+            mapped_file &operator=(mapped_file &&other) noexcept {
+                if (this != &other) {
+                    close();
+                    base = std::exchange(other.base, nullptr);
+                    length = std::exchange(other.length, 0);
+                }
+                return *this;
+            }
+
+            ~mapped_file() {
+                close();
+            }
+
+            bool open(const char *path) {
+                close();
+#if defined(_WIN32)
+                HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (file == INVALID_HANDLE_VALUE) return false;
+
+                LARGE_INTEGER file_size{};
+                HANDLE mapping = nullptr;
+                if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+                    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                }
+                CloseHandle(file);
+                if (!mapping) return false;
+
+                void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+                if (!view) return false;
+
+                base = static_cast<const unsigned char*>(view);
+                length = static_cast<std::size_t>(file_size.QuadPart);
+#else
+                const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+                if (fd < 0) return false;
+
+                struct stat info{};
+                void *view = MAP_FAILED;
+                if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+                    view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+                }
+                ::close(fd);
+                if (view == MAP_FAILED) return false;
+
+                base = static_cast<const unsigned char*>(view);
+                length = static_cast<std::size_t>(info.st_size);
+#endif
+                return true;
+            }
+
+            void close() {
+                if (!base) return;
+#if defined(_WIN32)
+                UnmapViewOfFile(base);
+#else
+                ::munmap(const_cast<unsigned char*>(base), length);
+#endif
+                base = nullptr;
+                length = 0;
+            }
+
+            const unsigned char *data() const { return base; }
+            std::size_t size() const { return length; }
+
+        private:
+            const unsigned char *base{};
+            std::size_t length{};
+        };
+
+        // Moves a finished temporary file over path in one step. Views still mapping the old file keep
+        // its contents until they open() again; on Windows the replace fails while the old file is mapped
+        inline bool replace_file(const char *from, const char *path) {
+#if defined(_WIN32)
+            const bool replaced = MoveFileExA(from, path, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+            const bool replaced = std::rename(from, path) == 0;
+#endif
+            if (!replaced) std::remove(from);
+            return replaced;
+        }
+    }
+
+    // Writes count values as a table file for obfuscxx_view<Type, Level, Seed>, under a fresh random nonce.
+    // The table is written to <path>.tmp and then replaces path, so open views are never truncated
+    template<obf_level Level, std::uint64_t Seed, class Type>
+    bool write_obfuscxx_table(const char *path, const Type *values, std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<Type>, "write_obfuscxx_table: element type must be trivially copyable");
+
+        const std::string temporary = std::string(path) + ".tmp";
+        std::FILE *file = std::fopen(temporary.c_str(), "wb");
+        if (!file) return false;
+
+        std::random_device device;
+        const std::uint64_t nonce = (static_cast<std::uint64_t>(device()) << 32) | device();
+
+        bool ok;
+        {
+            detail::table_writer writer(file, sizeof(Type), Level, Seed, nonce, detail::table_sign_extends<Type>());
+            ok = writer.write(values, count) && writer.finish();
+        }
+        ok = (std::fclose(file) == 0) && ok;
+
+        if (!ok) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return detail::replace_file(temporary.c_str(), path);
+    }
+
+    // Zero-copy view over a table file written by obfuscxx_table or write_obfuscxx_table. The file is
+    // mapped read-only and shared, so pages load lazily and the page cache serves every process using
+    // it; elements are decrypted on access and the key exists only in this object (Seed mixed with the
+    // file's nonce). open() rejects files written for another Seed, Level or element size
+    template<class Type, obf_level Level, std::uint64_t Seed> class obfuscxx_view {
+        static_assert(std::is_trivially_copyable_v<Type>, "obfuscxx_view: element type must be trivially copyable");
+
+        static constexpr std::uint32_t rounds = detail::table_rounds(Level);
+        static constexpr std::size_t stride = (sizeof(Type) + 7) / 8;
+        static constexpr std::size_t chunk_elements = stride < 64 ? 64 / stride : 1;
+
+    public:
+        using value_type = Type;
+
+        obfuscxx_view() = default;
+
+        explicit obfuscxx_view(const char *path) {
+            open(path);
+        }
+
+        obfuscxx_view(obfuscxx_view &&other) noexcept
+            : file(std::move(other.file)), blocks(std::exchange(other.blocks, nullptr)), elements(std::exchange(other.elements, 0)),
+              sign_extended(other.sign_extended) {
+            std::memcpy(keys, other.keys, sizeof(keys));
+        }
+
+        obfuscxx_view &operator=(obfuscxx_view &&other) noexcept {
+            if (this != &other) {
+                close();
+                file = std::move(other.file);
+                blocks = std::exchange(other.blocks, nullptr);
+                elements = std::exchange(other.elements, 0);
+                sign_extended = other.sign_extended;
+                std::memcpy(keys, other.keys, sizeof(keys));
+            }
+            return *this;
+        }
+
+        bool open(const char *path) {
+            close();
+            if (!file.open(path) || file.size() < sizeof(detail::table_header)) {
+                file.close();
+                return false;
+            }
+
+            detail::table_header header;
+            std::memcpy(&header, file.data(), sizeof(header));
+
+            const std::size_t capacity = (file.size() - sizeof(header)) / 8 / stride;
+            if (std::memcmp(header.magic, detail::table_magic, sizeof(header.magic)) != 0 ||
+                header.version != detail::table_version || header.level != static_cast<std::uint32_t>(Level) ||
+                header.rounds != rounds || header.element_size != sizeof(Type) || header.count > capacity) {
+                file.close();
+                return false;
+            }
+
+            detail::table_keys(Seed, header.nonce, Level, keys);
+            if (detail::table_check(header.nonce, keys, rounds) != header.check) {
+                close();
+                return false;
+            }
+
+            blocks = reinterpret_cast<const std::uint64_t*>(file.data() + sizeof(header));
+            elements = static_cast<std::size_t>(header.count);
+            sign_extended = (header.flags & detail::table_sign_extended) != 0;
+            return true;
+        }
+
+        void close() {
+            file.close();
+            blocks = nullptr;
+            elements = 0;
+            detail::wipe(keys, sizeof(keys));
+        }
+
+        bool is_open() const { return blocks != nullptr; }
+        std::size_t size() const { return elements; }
+        bool empty() const { return elements == 0; }
+
+        // Mapped ciphertext of all elements, stride blocks each
+        std::span<const std::uint64_t> ciphertext() const { return { blocks, elements * stride }; }
+
+        OBFUSCXX_FORCEINLINE Type get(std::size_t i) const {
+            std::uint64_t plain[stride];
+            const std::uint64_t *in = blocks + i * stride;
+            OBFUSCXX_MEM_BARRIER(in)
+            detail::xtea_decrypt_blocks<rounds>(in, plain, stride, keys);
+
+            struct { unsigned char bytes[sizeof(Type)]; } raw;
+            std::memcpy(raw.bytes, plain, sizeof(Type));
+            detail::wipe(plain, sizeof(plain));
+            return std::bit_cast<Type>(raw);
+        }
+
+        OBFUSCXX_FORCEINLINE Type operator[](std::size_t i) const {
+            return get(i);
+        }
+
+        // Decrypts count elements starting at index, a chunk of blocks at a time; clamped to size()
+        void copy_to(Type *out, std::size_t count, std::size_t index = 0) const {
+            if (index >= elements) return;
+            if (count > elements - index) count = elements - index;
+
+            std::uint64_t plain[chunk_elements * stride];
+
+            while (count) {
+                const std::size_t n = count < chunk_elements ? count : chunk_elements;
+
+                const std::uint64_t *in = blocks + index * stride;
+                OBFUSCXX_MEM_BARRIER(in)
+                detail::xtea_decrypt_blocks<rounds>(in, plain, n * stride, keys);
+
+                if constexpr (sizeof(Type) == stride * 8) {
+                    std::memcpy(out, plain, n * sizeof(Type));
+                } else {
+                    for (std::size_t e = 0; e < n; ++e) {
+                        std::memcpy(out + e, plain + e * stride, sizeof(Type));
+                    }
+                }
+
+                out += n;
+                index += n;
+                count -= n;
+            }
+
+            detail::wipe(plain, sizeof(plain));
+        }
+
+        struct iterator {
+            const obfuscxx_view *parent;
+            std::size_t index;
+
+            Type operator*() const { return parent->get(index); }
+
+            iterator &operator++() {
+                ++index;
+                return *this;
+            }
+
+            bool operator!=(const iterator &other) const { return index != other.index; }
+            bool operator==(const iterator &other) const { return index == other.index; }
+        };
+
+        iterator begin() const { return {this, 0}; }
+        iterator end() const { return {this, elements}; }
+
+        // One block per element and one key per table, so the needle is encrypted once and matched
+        // against the mapped ciphertext without decrypting it. Comparison is bitwise
+        OBFUSCXX_FORCEINLINE iterator find(Type val) const requires (sizeof(Type) <= 8) {
+            return {this, detail::find_u64(blocks, elements, encrypt(val))};
+        }
+
+        OBFUSCXX_FORCEINLINE std::size_t count(Type val) const requires (sizeof(Type) <= 8) {
+            return detail::count_u64(blocks, elements, encrypt(val));
+        }
+
+        OBFUSCXX_FORCEINLINE bool contains(Type val) const requires (sizeof(Type) <= 8) {
+            return find(val) != end();
+        }
+
+    private:
+        // Needle in the widening the file was written with, so tables from obfuscxx_table match too
+        std::uint64_t encrypt(Type val) const {
+            return detail::xtea_encrypt_block(detail::table_block(&val, sizeof(Type), sign_extended), keys, rounds);
+        }
+
+        detail::mapped_file file;
+        const std::uint64_t *blocks{};
+        std::size_t elements{};
+        bool sign_extended{};
+        std::uint32_t keys[rounds * 2]{};
+    };
+}
+
+#endif
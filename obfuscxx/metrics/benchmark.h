@@ -1,7 +1,24 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 #include <benchmark/benchmark.h>
 
 #include "include/obfuscxx.h"
+#include "include/obfuscxx_buffer.h"
+#include "include/obfuscxx_dispatch.h"
+#include "include/obfuscxx_rotating.h"
+#include "include/obfuscxx_view.h"
+
+#if defined(OBFUSCXX_LEAN) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#include <immintrin.h>
+#endif
 
 using namespace ngu;
 
@@ -77,6 +94,32 @@ static void BM_StringGet_High(benchmark::State& state) {
 }
 BENCHMARK(BM_StringGet_High);
 
+// Path assembled from three obfuscated pieces and a number at runtime, against one obf_concat instance
+static void BM_StringJoin_Runtime(benchmark::State& state) {
+    obfuscxx<char, 9, obf_level::Low> root("C:\\data\\");
+    obfuscxx<char, 7, obf_level::Low> name("model_");
+    obfuscxx<char, 5, obf_level::Low> extension(".bin");
+    int version = 42;
+    benchmark::DoNotOptimize(version);
+
+    for (auto _ : state) {
+        std::string path = root.to_string().c_str();
+        path += name.to_string().c_str();
+        path += std::to_string(version);
+        path += extension.to_string().c_str();
+        benchmark::DoNotOptimize(path.data());
+    }
+}
+BENCHMARK(BM_StringJoin_Runtime);
+
+static void BM_StringJoin_Concat(benchmark::State& state) {
+    const auto path = obf_concat("C:\\data\\", "model_", 42, ".bin");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(path.to_string().c_str());
+    }
+}
+BENCHMARK(BM_StringJoin_Concat);
+
 static void BM_WStringGet_Low(benchmark::State& state) {
     obfuscxx<wchar_t, 10, obf_level::Low> str(L"benchmark");
     for (auto _ : state) {
@@ -159,4 +202,800 @@ static void BM_ArrayGet_High(benchmark::State& state) {
         benchmark::DoNotOptimize(array.get(50));
     }
 }
-BENCHMARK(BM_ArrayGet_High);
\ No newline at end of file
+BENCHMARK(BM_ArrayGet_High);
+
+static void BM_ArrayContains_Low(benchmark::State& state) {
+    obfuscxx<std::uint64_t, 1024, obf_level::Low> array{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(array.contains(0xDEADBEEF));
+    }
+}
+BENCHMARK(BM_ArrayContains_Low);
+
+static void BM_ArrayContains_Medium(benchmark::State& state) {
+    obfuscxx<std::uint64_t, 1024, obf_level::Medium> array{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(array.contains(0xDEADBEEF));
+    }
+}
+BENCHMARK(BM_ArrayContains_Medium);
+
+static void BM_ArrayContains_High(benchmark::State& state) {
+    obfuscxx<std::uint64_t, 1024, obf_level::High> array{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(array.contains(0xDEADBEEF));
+    }
+}
+BENCHMARK(BM_ArrayContains_High);
+
+static void BM_ArrayContainsDecrypt_Low(benchmark::State& state) {
+    obfuscxx<std::uint64_t, 1024, obf_level::Low> array{};
+    for (auto _ : state) {
+        bool found = false;
+        for (auto val : array) {
+            if (val == 0xDEADBEEF) {
+                found = true;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+BENCHMARK(BM_ArrayContainsDecrypt_Low);
+
+static void BM_ArrayContainsDecrypt_Medium(benchmark::State& state) {
+    obfuscxx<std::uint64_t, 1024, obf_level::Medium> array{};
+    for (auto _ : state) {
+        bool found = false;
+        for (auto val : array) {
+            if (val == 0xDEADBEEF) {
+                found = true;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+BENCHMARK(BM_ArrayContainsDecrypt_Medium);
+
+static void BM_ArrayContainsDecrypt_High(benchmark::State& state) {
+    obfuscxx<std::uint64_t, 1024, obf_level::High> array{};
+    for (auto _ : state) {
+        bool found = false;
+        for (auto val : array) {
+            if (val == 0xDEADBEEF) {
+                found = true;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+BENCHMARK(BM_ArrayContainsDecrypt_High);
+
+static void BM_StringStream_Low(benchmark::State& state) {
+    obfuscxx<char, 10, obf_level::Low> str("benchmark");
+    std::ostringstream os;
+    for (auto _ : state) {
+        os.seekp(0);
+        os << str;
+        benchmark::DoNotOptimize(os);
+    }
+}
+BENCHMARK(BM_StringStream_Low);
+
+static void BM_StringStreamCopy_Low(benchmark::State& state) {
+    obfuscxx<char, 10, obf_level::Low> str("benchmark");
+    std::ostringstream os;
+    for (auto _ : state) {
+        os.seekp(0);
+        os << str.to_string().c_str();
+        benchmark::DoNotOptimize(os);
+    }
+}
+BENCHMARK(BM_StringStreamCopy_Low);
+
+static void BM_StringStream_Medium(benchmark::State& state) {
+    obfuscxx<char, 10, obf_level::Medium> str("benchmark");
+    std::ostringstream os;
+    for (auto _ : state) {
+        os.seekp(0);
+        os << str;
+        benchmark::DoNotOptimize(os);
+    }
+}
+BENCHMARK(BM_StringStream_Medium);
+
+static void BM_StringStreamCopy_Medium(benchmark::State& state) {
+    obfuscxx<char, 10, obf_level::Medium> str("benchmark");
+    std::ostringstream os;
+    for (auto _ : state) {
+        os.seekp(0);
+        os << str.to_string().c_str();
+        benchmark::DoNotOptimize(os);
+    }
+}
+BENCHMARK(BM_StringStreamCopy_Medium);
+
+static void BM_StringStream_High(benchmark::State& state) {
+    obfuscxx<char, 10, obf_level::High> str("benchmark");
+    std::ostringstream os;
+    for (auto _ : state) {
+        os.seekp(0);
+        os << str;
+        benchmark::DoNotOptimize(os);
+    }
+}
+BENCHMARK(BM_StringStream_High);
+
+static void BM_StringStreamCopy_High(benchmark::State& state) {
+    obfuscxx<char, 10, obf_level::High> str("benchmark");
+    std::ostringstream os;
+    for (auto _ : state) {
+        os.seekp(0);
+        os << str.to_string().c_str();
+        benchmark::DoNotOptimize(os);
+    }
+}
+BENCHMARK(BM_StringStreamCopy_High);
+
+struct bench_config { std::uint64_t fields[8]; };
+
+static void BM_ObjectGet_Low(benchmark::State& state) {
+    obfuscxx<bench_config, 1, obf_level::Low> config{ bench_config{ 1, 2, 3, 4, 5, 6, 7, 8 } };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(config.get());
+    }
+}
+BENCHMARK(BM_ObjectGet_Low);
+
+static void BM_ObjectFieldsGet_Low(benchmark::State& state) {
+    obfuscxx<std::uint64_t, 1, obf_level::Low> f0{ 1 }, f1{ 2 }, f2{ 3 }, f3{ 4 }, f4{ 5 }, f5{ 6 }, f6{ 7 }, f7{ 8 };
+    for (auto _ : state) {
+        bench_config config{ f0.get(), f1.get(), f2.get(), f3.get(), f4.get(), f5.get(), f6.get(), f7.get() };
+        benchmark::DoNotOptimize(config);
+    }
+}
+BENCHMARK(BM_ObjectFieldsGet_Low);
+
+static void BM_ObjectGet_Medium(benchmark::State& state) {
+    obfuscxx<bench_config, 1, obf_level::Medium> config{ bench_config{ 1, 2, 3, 4, 5, 6, 7, 8 } };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(config.get());
+    }
+}
+BENCHMARK(BM_ObjectGet_Medium);
+
+static void BM_ObjectFieldsGet_Medium(benchmark::State& state) {
+    obfuscxx<std::uint64_t, 1, obf_level::Medium> f0{ 1 }, f1{ 2 }, f2{ 3 }, f3{ 4 }, f4{ 5 }, f5{ 6 }, f6{ 7 }, f7{ 8 };
+    for (auto _ : state) {
+        bench_config config{ f0.get(), f1.get(), f2.get(), f3.get(), f4.get(), f5.get(), f6.get(), f7.get() };
+        benchmark::DoNotOptimize(config);
+    }
+}
+BENCHMARK(BM_ObjectFieldsGet_Medium);
+
+static void BM_ObjectGet_High(benchmark::State& state) {
+    obfuscxx<bench_config, 1, obf_level::High> config{ bench_config{ 1, 2, 3, 4, 5, 6, 7, 8 } };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(config.get());
+    }
+}
+BENCHMARK(BM_ObjectGet_High);
+
+static void BM_ObjectFieldsGet_High(benchmark::State& state) {
+    obfuscxx<std::uint64_t, 1, obf_level::High> f0{ 1 }, f1{ 2 }, f2{ 3 }, f3{ 4 }, f4{ 5 }, f5{ 6 }, f6{ 7 }, f7{ 8 };
+    for (auto _ : state) {
+        bench_config config{ f0.get(), f1.get(), f2.get(), f3.get(), f4.get(), f5.get(), f6.get(), f7.get() };
+        benchmark::DoNotOptimize(config);
+    }
+}
+BENCHMARK(BM_ObjectFieldsGet_High);
+
+static void BM_GetAll_Low(benchmark::State& state) {
+    obfuscxx<int, 1, obf_level::Low> a{ 1 };
+    obfuscxx<float, 1, obf_level::Low> b{ 2.5f };
+    obfuscxx<int, 1, obf_level::Low> c{ 3 };
+    obfuscxx<double, 1, obf_level::Low> d{ 4.5 };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(get_all(a, b, c, d));
+    }
+}
+BENCHMARK(BM_GetAll_Low);
+
+static void BM_GetSeparate_Low(benchmark::State& state) {
+    obfuscxx<int, 1, obf_level::Low> a{ 1 };
+    obfuscxx<float, 1, obf_level::Low> b{ 2.5f };
+    obfuscxx<int, 1, obf_level::Low> c{ 3 };
+    obfuscxx<double, 1, obf_level::Low> d{ 4.5 };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::tuple{ a.get(), b.get(), c.get(), d.get() });
+    }
+}
+BENCHMARK(BM_GetSeparate_Low);
+
+static void BM_GetAll_Medium(benchmark::State& state) {
+    obfuscxx<int, 1, obf_level::Medium> a{ 1 };
+    obfuscxx<float, 1, obf_level::Medium> b{ 2.5f };
+    obfuscxx<int, 1, obf_level::Medium> c{ 3 };
+    obfuscxx<double, 1, obf_level::Medium> d{ 4.5 };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(get_all(a, b, c, d));
+    }
+}
+BENCHMARK(BM_GetAll_Medium);
+
+static void BM_GetSeparate_Medium(benchmark::State& state) {
+    obfuscxx<int, 1, obf_level::Medium> a{ 1 };
+    obfuscxx<float, 1, obf_level::Medium> b{ 2.5f };
+    obfuscxx<int, 1, obf_level::Medium> c{ 3 };
+    obfuscxx<double, 1, obf_level::Medium> d{ 4.5 };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::tuple{ a.get(), b.get(), c.get(), d.get() });
+    }
+}
+BENCHMARK(BM_GetSeparate_Medium);
+
+static void BM_GetAll_High(benchmark::State& state) {
+    obfuscxx<int, 1, obf_level::High> a{ 1 };
+    obfuscxx<float, 1, obf_level::High> b{ 2.5f };
+    obfuscxx<int, 1, obf_level::High> c{ 3 };
+    obfuscxx<double, 1, obf_level::High> d{ 4.5 };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(get_all(a, b, c, d));
+    }
+}
+BENCHMARK(BM_GetAll_High);
+
+static void BM_GetSeparate_High(benchmark::State& state) {
+    obfuscxx<int, 1, obf_level::High> a{ 1 };
+    obfuscxx<float, 1, obf_level::High> b{ 2.5f };
+    obfuscxx<int, 1, obf_level::High> c{ 3 };
+    obfuscxx<double, 1, obf_level::High> d{ 4.5 };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::tuple{ a.get(), b.get(), c.get(), d.get() });
+    }
+}
+BENCHMARK(BM_GetSeparate_High);
+
+static void BM_ArrayAssign_Low(benchmark::State& state) {
+    obfuscxx<int, 1024, obf_level::Low> array{};
+    std::array<int, 1024> values{};
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>(i);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values);
+        array.assign(values);
+        benchmark::DoNotOptimize(array);
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(values));
+}
+BENCHMARK(BM_ArrayAssign_Low);
+
+static void BM_ArraySet_Low(benchmark::State& state) {
+    obfuscxx<int, 1024, obf_level::Low> array{};
+    std::array<int, 1024> values{};
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>(i);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            array.set(values[i], i);
+        }
+        benchmark::DoNotOptimize(array);
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(values));
+}
+BENCHMARK(BM_ArraySet_Low);
+
+static void BM_ArrayAssign_Medium(benchmark::State& state) {
+    obfuscxx<int, 1024, obf_level::Medium> array{};
+    std::array<int, 1024> values{};
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>(i);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values);
+        array.assign(values);
+        benchmark::DoNotOptimize(array);
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(values));
+}
+BENCHMARK(BM_ArrayAssign_Medium);
+
+static void BM_ArraySet_Medium(benchmark::State& state) {
+    obfuscxx<int, 1024, obf_level::Medium> array{};
+    std::array<int, 1024> values{};
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>(i);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            array.set(values[i], i);
+        }
+        benchmark::DoNotOptimize(array);
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(values));
+}
+BENCHMARK(BM_ArraySet_Medium);
+
+static void BM_ArrayAssign_High(benchmark::State& state) {
+    obfuscxx<int, 1024, obf_level::High> array{};
+    std::array<int, 1024> values{};
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>(i);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values);
+        array.assign(values);
+        benchmark::DoNotOptimize(array);
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(values));
+}
+BENCHMARK(BM_ArrayAssign_High);
+
+static void BM_ArraySet_High(benchmark::State& state) {
+    obfuscxx<int, 1024, obf_level::High> array{};
+    std::array<int, 1024> values{};
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>(i);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            array.set(values[i], i);
+        }
+        benchmark::DoNotOptimize(array);
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(values));
+}
+BENCHMARK(BM_ArraySet_High);
+
+// Cold-cache / tail-latency mode: every timed get() goes to a random instance out of a working set
+// larger than the last-level cache, and each access is timed on its own so the percentiles show the
+// tail next to the mean. Modes: 0 = one hot instance (baseline with the same timer overhead),
+// 1 = spread over the working set, 2 = spread plus a flush of the accessed line before each access
+namespace cold {
+    template<obf_level Level> struct alignas(64) slot {
+        obfuscxx<int, 1, Level> value{};
+    };
+
+    inline std::size_t working_set_bytes() {
+        if (const char *env = std::getenv("OBFUSCXX_COLD_WORKING_SET_MB"); env && *env) {
+            return static_cast<std::size_t>(std::strtoull(env, nullptr, 10)) << 20;
+        }
+
+        // CacheInfo::size is already one instance of the cache, num_sharing only counts its CPUs
+        int level = 0;
+        std::size_t llc = 0;
+        for (const auto &cache : benchmark::CPUInfo::Get().caches) {
+            if (cache.level > level) {
+                level = cache.level;
+                llc = 0;
+            }
+            if (cache.level == level) llc = (std::max)(llc, static_cast<std::size_t>(cache.size));
+        }
+        return std::clamp<std::size_t>(llc * 2, std::size_t{ 64 } << 20, std::size_t{ 1 } << 30);
+    }
+
+    inline void flush(const void *p) {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        _mm_clflush(p);
+        _mm_mfence();
+#elif (defined(__aarch64__)) && (defined(__clang__) || defined(__GNUC__))
+        __asm__ volatile("dc civac, %0\n\tdsb ish" :: "r"(p) : "memory");
+#else
+        (void)p;
+#endif
+    }
+
+    template<obf_level Level> void get(benchmark::State& state) {
+        const auto mode = state.range(0);
+        const std::size_t count = mode == 0 ? 1 : working_set_bytes() / sizeof(slot<Level>);
+
+        const auto slots = std::make_unique<slot<Level>[]>(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            slots[i].value = static_cast<int>(i);
+        }
+
+        // Random visiting order so the hardware prefetcher cannot follow it
+        std::vector<std::uint32_t> order(std::size_t{ 1 } << 20);
+        std::uint64_t x = 0x9E3779B97F4A7C15;
+        for (auto &index : order) {
+            x = detail::splitmix64(x);
+            index = static_cast<std::uint32_t>(x % count);
+        }
+
+        std::vector<double> samples;
+        samples.reserve(static_cast<std::size_t>(state.max_iterations));
+
+        std::size_t next = 0;
+        for (auto _ : state) {
+            const auto &target = slots[order[next++ & (order.size() - 1)]].value;
+            if (mode == 2) flush(&target);
+
+            const auto start = std::chrono::steady_clock::now();
+            benchmark::DoNotOptimize(target.get());
+            const auto end = std::chrono::steady_clock::now();
+
+            const double seconds = std::chrono::duration<double>(end - start).count();
+            state.SetIterationTime(seconds);
+            samples.push_back(seconds * 1e9);
+        }
+
+        const auto percentile = [&](double p) {
+            auto nth = samples.begin() + static_cast<std::ptrdiff_t>(p * static_cast<double>(samples.size() - 1));
+            std::nth_element(samples.begin(), nth, samples.end());
+            return *nth;
+        };
+        if (!samples.empty()) {
+            state.counters["p50_ns"] = percentile(0.50);
+            state.counters["p99_ns"] = percentile(0.99);
+            state.counters["p999_ns"] = percentile(0.999);
+        }
+        state.counters["working_set_mb"] = static_cast<double>(count * sizeof(slot<Level>)) / (1 << 20);
+    }
+}
+
+static void BM_ColdGet_Low(benchmark::State& state) {
+    cold::get<obf_level::Low>(state);
+}
+BENCHMARK(BM_ColdGet_Low)->ArgName("mode")->DenseRange(0, 2)->Iterations(200000)->UseManualTime();
+
+static void BM_ColdGet_Medium(benchmark::State& state) {
+    cold::get<obf_level::Medium>(state);
+}
+BENCHMARK(BM_ColdGet_Medium)->ArgName("mode")->DenseRange(0, 2)->Iterations(200000)->UseManualTime();
+
+static void BM_ColdGet_High(benchmark::State& state) {
+    cold::get<obf_level::High>(state);
+}
+BENCHMARK(BM_ColdGet_High)->ArgName("mode")->DenseRange(0, 2)->Iterations(200000)->UseManualTime();
+
+namespace dispatch_bench {
+    int add(int value) { return value + 3; }
+    int sub(int value) { return value - 3; }
+    int mul(int value) { return value * 3; }
+    int shl(int value) { return value << 3; }
+
+    // Rotating index so the indirect branch target changes every call
+    template<class Table> void run(benchmark::State& state, const Table &table) {
+        std::size_t i = 0;
+        int value = 1;
+        for (auto _ : state) {
+            value = table(i++ & 3, value) & 0xFFFF;
+            benchmark::DoNotOptimize(value);
+        }
+    }
+}
+
+static void BM_DispatchPlain(benchmark::State& state) {
+    using namespace dispatch_bench;
+    int (*table[])(int) = { &add, &sub, &mul, &shl };
+    benchmark::DoNotOptimize(table);
+    std::size_t i = 0;
+    int value = 1;
+    for (auto _ : state) {
+        value = table[i++ & 3](value) & 0xFFFF;
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_DispatchPlain);
+
+static void BM_DispatchDecrypted(benchmark::State& state) {
+    using namespace dispatch_bench;
+    obfuscated_dispatch_table<int(int), 4, dispatch_mode::decrypted> table{ &add, &sub, &mul, &shl };
+    run(state, table);
+}
+BENCHMARK(BM_DispatchDecrypted);
+
+static void BM_DispatchPerCall_Low(benchmark::State& state) {
+    using namespace dispatch_bench;
+    obfuscated_dispatch_table<int(int), 4, dispatch_mode::per_call, obf_level::Low> table{ &add, &sub, &mul, &shl };
+    run(state, table);
+}
+BENCHMARK(BM_DispatchPerCall_Low);
+
+static void BM_DispatchPerCall_Medium(benchmark::State& state) {
+    using namespace dispatch_bench;
+    obfuscated_dispatch_table<int(int), 4, dispatch_mode::per_call, obf_level::Medium> table{ &add, &sub, &mul, &shl };
+    run(state, table);
+}
+BENCHMARK(BM_DispatchPerCall_Medium);
+
+static void BM_DispatchPerCall_High(benchmark::State& state) {
+    using namespace dispatch_bench;
+    obfuscated_dispatch_table<int(int), 4, dispatch_mode::per_call, obf_level::High> table{ &add, &sub, &mul, &shl };
+    run(state, table);
+}
+BENCHMARK(BM_DispatchPerCall_High);
+
+static void BM_DispatchArrayGet_Low(benchmark::State& state) {
+    using namespace dispatch_bench;
+    obfuscxx<int(*)(int), 4, obf_level::Low> table{};
+    table = { &add, &sub, &mul, &shl };
+    std::size_t i = 0;
+    int value = 1;
+    for (auto _ : state) {
+        value = table.get(i++ & 3)(value) & 0xFFFF;
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_DispatchArrayGet_Low);
+
+// Key rotation: lock-free read cost, read cost while a background thread keeps rotating (readers retry
+// when their chunk's sequence moves), and the cost of one rotate_step slice on the writer side
+namespace rotating_bench {
+    using table = obfuscxx_rotating<int, 1 << 16, obf_level::Medium>;
+
+    inline std::unique_ptr<table> make() {
+        std::vector<int> values(table::size());
+        for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>(i);
+        return std::make_unique<table>(values);
+    }
+}
+
+static void BM_RotatingGet_Medium(benchmark::State& state) {
+    auto array = rotating_bench::make();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(array->get(i++ & (rotating_bench::table::size() - 1)));
+    }
+}
+BENCHMARK(BM_RotatingGet_Medium);
+
+static void BM_RotatingGetDuringRotation_Medium(benchmark::State& state) {
+    auto array = rotating_bench::make();
+    array->start_background_rotation(std::chrono::milliseconds(0), 1);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(array->get(i++ & (rotating_bench::table::size() - 1)));
+    }
+    array->stop_background_rotation();
+    state.counters["generations"] = array->generation();
+}
+BENCHMARK(BM_RotatingGetDuringRotation_Medium);
+
+static void BM_RotateSlice_Medium(benchmark::State& state) {
+    auto array = rotating_bench::make();
+    const auto chunks = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        if (!array->rotating()) array->begin_rotation();
+        array->rotate_step(chunks);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(chunks * rotating_bench::table::chunk_size()));
+}
+BENCHMARK(BM_RotateSlice_Medium)->ArgName("chunks")->Arg(1)->Arg(16);
+
+static void BM_RotateFull_Medium(benchmark::State& state) {
+    auto array = rotating_bench::make();
+    for (auto _ : state) {
+        array->rotate(16);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(rotating_bench::table::size() * 8));
+}
+BENCHMARK(BM_RotateFull_Medium);
+
+// Bulk kernels: hand-tuned intrinsics against the generic lane-wrapper kernel at several widths
+namespace kernel_bench {
+    constexpr std::uint64_t iv[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    constexpr auto schedule = detail::make_xtea_schedule<6>(iv, 0x9E3779B9);
+
+    template<class Kernel> void run(benchmark::State& state, Kernel kernel) {
+        std::vector<std::uint64_t> in(4096), out(4096);
+        for (std::size_t i = 0; i < in.size(); ++i) in[i] = detail::splitmix64(i);
+        for (auto _ : state) {
+            kernel(in.data(), out.data(), in.size());
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(in.size() * 8));
+    }
+}
+
+static void BM_BulkDecrypt_Tuned(benchmark::State& state) {
+    kernel_bench::run(state, [](const std::uint64_t *in, std::uint64_t *out, std::size_t count) {
+        detail::xtea_decrypt_blocks<6>(in, out, count, kernel_bench::schedule.keys);
+    });
+}
+BENCHMARK(BM_BulkDecrypt_Tuned);
+
+static void BM_BulkDecrypt_Generic4(benchmark::State& state) {
+    kernel_bench::run(state, [](const std::uint64_t *in, std::uint64_t *out, std::size_t count) {
+        detail::simd::xtea_blocks<4, 6, false>(in, out, count, kernel_bench::schedule.keys);
+    });
+}
+BENCHMARK(BM_BulkDecrypt_Generic4);
+
+static void BM_BulkDecrypt_Generic8(benchmark::State& state) {
+    kernel_bench::run(state, [](const std::uint64_t *in, std::uint64_t *out, std::size_t count) {
+        detail::simd::xtea_blocks<8, 6, false>(in, out, count, kernel_bench::schedule.keys);
+    });
+}
+BENCHMARK(BM_BulkDecrypt_Generic8);
+
+static void BM_BulkDecrypt_Generic16(benchmark::State& state) {
+    kernel_bench::run(state, [](const std::uint64_t *in, std::uint64_t *out, std::size_t count) {
+        detail::simd::xtea_blocks<16, 6, false>(in, out, count, kernel_bench::schedule.keys);
+    });
+}
+BENCHMARK(BM_BulkDecrypt_Generic16);
+
+static void BM_BulkEncrypt_Tuned(benchmark::State& state) {
+    kernel_bench::run(state, [](const std::uint64_t *in, std::uint64_t *out, std::size_t count) {
+        detail::xtea_encrypt_blocks<6>(in, out, count, kernel_bench::schedule.keys);
+    });
+}
+BENCHMARK(BM_BulkEncrypt_Tuned);
+
+static void BM_BulkEncrypt_Generic(benchmark::State& state) {
+    kernel_bench::run(state, [](const std::uint64_t *in, std::uint64_t *out, std::size_t count) {
+        detail::simd::xtea_blocks<detail::simd::native_lanes, 6, true>(in, out, count, kernel_bench::schedule.keys);
+    });
+}
+BENCHMARK(BM_BulkEncrypt_Generic);
+
+// Runtime buffers: append (encrypt) and copy_to (decrypt) throughput in bytes, for 4 KiB and 1 MiB
+namespace buffer_bench {
+    template<obf_level Level> void append(benchmark::State& state) {
+        std::vector<std::uint64_t> values(static_cast<std::size_t>(state.range(0)) / 8);
+        for (std::size_t i = 0; i < values.size(); ++i) values[i] = detail::splitmix64(i);
+
+        obfuscxx_buffer<std::uint64_t, Level> buffer;
+        buffer.reserve(values.size());
+        for (auto _ : state) {
+            buffer.clear();
+            buffer.append(values);
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    template<obf_level Level> void copy_to(benchmark::State& state) {
+        std::vector<std::uint64_t> values(static_cast<std::size_t>(state.range(0)) / 8), out(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) values[i] = detail::splitmix64(i);
+
+        obfuscxx_buffer<std::uint64_t, Level> buffer{ values };
+        for (auto _ : state) {
+            buffer.copy_to(out.data(), out.size());
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+}
+
+static void BM_BufferAppend_Low(benchmark::State& state) { buffer_bench::append<obf_level::Low>(state); }
+BENCHMARK(BM_BufferAppend_Low)->Arg(4 << 10)->Arg(1 << 20);
+
+static void BM_BufferAppend_Medium(benchmark::State& state) { buffer_bench::append<obf_level::Medium>(state); }
+BENCHMARK(BM_BufferAppend_Medium)->Arg(4 << 10)->Arg(1 << 20);
+
+static void BM_BufferAppend_High(benchmark::State& state) { buffer_bench::append<obf_level::High>(state); }
+BENCHMARK(BM_BufferAppend_High)->Arg(4 << 10)->Arg(1 << 20);
+
+static void BM_BufferCopyTo_Low(benchmark::State& state) { buffer_bench::copy_to<obf_level::Low>(state); }
+BENCHMARK(BM_BufferCopyTo_Low)->Arg(4 << 10)->Arg(1 << 20);
+
+static void BM_BufferCopyTo_Medium(benchmark::State& state) { buffer_bench::copy_to<obf_level::Medium>(state); }
+BENCHMARK(BM_BufferCopyTo_Medium)->Arg(4 << 10)->Arg(1 << 20);
+
+static void BM_BufferCopyTo_High(benchmark::State& state) { buffer_bench::copy_to<obf_level::High>(state); }
+BENCHMARK(BM_BufferCopyTo_High)->Arg(4 << 10)->Arg(1 << 20);
+
+// Mapped table files: 8 MiB of std::uint64_t, decrypted from the page cache or searched as ciphertext
+namespace view_bench {
+    using table = obfuscxx_view<std::uint64_t, obf_level::Medium, 0xC0FFEE>;
+    constexpr std::size_t size = 1 << 20;
+
+    // One file per process, several test binaries run concurrently under ctest -j; removed at exit
+    struct table_file {
+        std::string path;
+
+        table_file() : path((std::filesystem::temp_directory_path() /
+                             ("obfuscxx_view_bench_" + std::to_string(detail::runtime_nonce()) + ".obft")).string()) {
+            std::vector<std::uint64_t> values(size);
+            for (std::size_t i = 0; i < values.size(); ++i) values[i] = detail::splitmix64(i);
+            write_obfuscxx_table<obf_level::Medium, 0xC0FFEE>(path.c_str(), values.data(), values.size());
+        }
+
+        ~table_file() {
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+    };
+
+    inline table open() {
+        static const table_file file;
+        return table{ file.path.c_str() };
+    }
+}
+
+static void BM_ViewGet_Medium(benchmark::State& state) {
+    const auto view = view_bench::open();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view.get((i++ * 7919) & (view_bench::size - 1)));
+    }
+}
+BENCHMARK(BM_ViewGet_Medium);
+
+static void BM_ViewCopyTo_Medium(benchmark::State& state) {
+    const auto view = view_bench::open();
+    std::vector<std::uint64_t> out(view.size());
+    for (auto _ : state) {
+        view.copy_to(out.data(), out.size());
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(view.size() * 8));
+}
+BENCHMARK(BM_ViewCopyTo_Medium);
+
+static void BM_ViewCount_Medium(benchmark::State& state) {
+    const auto view = view_bench::open();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view.count(detail::splitmix64(12345)));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(view.size() * 8));
+}
+BENCHMARK(BM_ViewCount_Medium);
+
+// Dot product over an obfuscated coefficient table: copy_to a plaintext buffer and reload it, against
+// load_decrypted feeding the multiply straight from the decrypt kernel
+#if !defined(__aarch64__) && !defined(_M_ARM64) && !defined(OBFUSCXX_LEAN)
+namespace register_bench {
+    template<obf_level Level> struct table {
+        obfuscxx<float, 256, Level> coefficients{};
+        alignas(16) float input[256];
+
+        table() {
+            std::array<float, 256> values{};
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                values[i] = static_cast<float>(i) * 0.5f;
+                input[i] = 1.0f / static_cast<float>(i + 1);
+            }
+            coefficients.assign(values);
+        }
+    };
+
+    inline float horizontal_sum(__m128 v) {
+        v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+        return _mm_cvtss_f32(v);
+    }
+
+    template<obf_level Level> void copy(benchmark::State& state) {
+        table<Level> t;
+        alignas(16) float plain[256];
+        for (auto _ : state) {
+            t.coefficients.copy_to(plain, 256);
+            __m128 acc = _mm_setzero_ps();
+            for (std::size_t i = 0; i < 256; i += 4) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_load_ps(plain + i), _mm_load_ps(t.input + i)));
+            }
+            benchmark::DoNotOptimize(horizontal_sum(acc));
+        }
+    }
+
+    template<obf_level Level> void direct(benchmark::State& state) {
+        table<Level> t;
+        for (auto _ : state) {
+            __m128 acc = _mm_setzero_ps();
+            for (std::size_t i = 0; i < 256; i += 4) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(t.coefficients.template load_decrypted<4>(i), _mm_load_ps(t.input + i)));
+            }
+            benchmark::DoNotOptimize(horizontal_sum(acc));
+        }
+    }
+}
+
+static void BM_DotCopyTo_Low(benchmark::State& state) { register_bench::copy<obf_level::Low>(state); }
+BENCHMARK(BM_DotCopyTo_Low);
+
+static void BM_DotLoadDecrypted_Low(benchmark::State& state) { register_bench::direct<obf_level::Low>(state); }
+BENCHMARK(BM_DotLoadDecrypted_Low);
+
+static void BM_DotCopyTo_Medium(benchmark::State& state) { register_bench::copy<obf_level::Medium>(state); }
+BENCHMARK(BM_DotCopyTo_Medium);
+
+static void BM_DotLoadDecrypted_Medium(benchmark::State& state) { register_bench::direct<obf_level::Medium>(state); }
+BENCHMARK(BM_DotLoadDecrypted_Medium);
+
+static void BM_DotCopyTo_High(benchmark::State& state) { register_bench::copy<obf_level::High>(state); }
+BENCHMARK(BM_DotCopyTo_High);
+
+static void BM_DotLoadDecrypted_High(benchmark::State& state) { register_bench::direct<obf_level::High>(state); }
+BENCHMARK(BM_DotLoadDecrypted_High);
+#endif
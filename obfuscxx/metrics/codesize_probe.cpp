@@ -0,0 +1,21 @@
+#include "include/obfuscxx.h"
+
+using namespace ngu;
+
+// One obfuscxx use per TU, configured by cmake/codesize_report.cmake:
+// OBFUSCXX_PROBE_TYPE, OBFUSCXX_PROBE_SIZE, OBFUSCXX_PROBE_LEVEL (or OBFUSCXX_PROBE_BASELINE)
+#if defined(OBFUSCXX_PROBE_BASELINE)
+extern "C" void obfuscxx_probe(void *out) {
+    *static_cast<volatile int*>(out) = 42;
+}
+#else
+extern "C" void obfuscxx_probe(void *out) {
+    obfuscxx<OBFUSCXX_PROBE_TYPE, OBFUSCXX_PROBE_SIZE, obf_level::OBFUSCXX_PROBE_LEVEL> value{};
+
+#if OBFUSCXX_PROBE_SIZE == 1
+    *static_cast<OBFUSCXX_PROBE_TYPE*>(out) = value.get();
+#else
+    value.copy_to(static_cast<OBFUSCXX_PROBE_TYPE*>(out), OBFUSCXX_PROBE_SIZE);
+#endif
+}
+#endif
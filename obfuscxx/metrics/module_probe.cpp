@@ -0,0 +1,30 @@
+// Consumer of ngu.obfuscxx built by cmake/check_module.cmake; exits non-zero on a wrong value
+import ngu.obfuscxx;
+
+using namespace ngu;
+
+int main() {
+    obfuscxx<int, 1, obf_level::Low, site_entropy()> integer{ 42 };
+    obfuscxx<float, 1, obf_level::Medium, site_entropy()> real{ 1.5f };
+    obfuscxx<long long, 100, obf_level::High, site_entropy()> array{
+        0LL, 1LL, 2LL, 3LL, 4LL, 5LL, 6LL, 7LL, 8LL, 9LL, 10LL, 11LL, 12LL, 13LL, 14LL, 15LL, 16LL, 17LL, 18LL, 19LL,
+        20LL, 21LL, 22LL, 23LL, 24LL, 25LL, 26LL, 27LL, 28LL, 29LL, 30LL, 31LL, 32LL, 33LL, 34LL, 35LL, 36LL, 37LL, 38LL, 39LL,
+        40LL, 41LL, 42LL, 43LL, 44LL, 45LL, 46LL, 47LL, 48LL, 49LL, 50LL, 51LL, 52LL, 53LL, 54LL, 55LL, 56LL, 57LL, 58LL, 59LL,
+        60LL, 61LL, 62LL, 63LL, 64LL, 65LL, 66LL, 67LL, 68LL, 69LL, 70LL, 71LL, 72LL, 73LL, 74LL, 75LL, 76LL, 77LL, 78LL, 79LL,
+        80LL, 81LL, 82LL, 83LL, 84LL, 85LL, 86LL, 87LL, 88LL, 89LL, 90LL, 91LL, 92LL, 93LL, 94LL, 95LL, 96LL, 97LL, 98LL, 99LL };
+    obfuscxx<char, 14, obf_level::Medium, site_entropy()> text{ "module probe!" };
+
+    long long copy[100];
+    array.copy_to(copy, 100);
+
+    int failures = 0;
+    failures += integer.get() != 42;
+    failures += real.get() != 1.5f;
+    failures += array.get(77) != 77;
+    failures += !array.contains(64) || *array.find(64) != 64;
+    for (long long i = 0; i < 100; ++i) failures += copy[i] != i;
+    const auto plain = text.to_string();
+    const char expected[] = "module probe!";
+    for (unsigned i = 0; i < sizeof(expected); ++i) failures += plain[i] != expected[i];
+    return failures;
+}
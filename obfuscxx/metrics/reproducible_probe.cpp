@@ -0,0 +1,16 @@
+#include "include/obfuscxx.h"
+
+using namespace ngu;
+
+int probe_integer() {
+    return obfuscxx<int, 1, obf_level::High>{ 42 }.get();
+}
+
+float probe_float() {
+    return obfuscxx<float, 1, obf_level::Medium>{ 1.5f }.get();
+}
+
+const char *probe_string() {
+    static const auto str = obfuscxx("reproducible build probe").to_string();
+    return str.c_str();
+}
@@ -1,8 +1,23 @@
 #pragma once
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "include/obfuscxx.h"
+#include "include/obfuscxx_buffer.h"
+#include "include/obfuscxx_dispatch.h"
+#include "include/obfuscxx_format.h"
+#include "include/obfuscxx_rotating.h"
+#include "include/obfuscxx_view.h"
 
 using namespace ngu;
 
@@ -283,4 +298,779 @@ TEST(ObfuscxxTest, UserDefinedLiterals) {
     EXPECT_STREQ("small test string"_obf, "small test string");
     EXPECT_STREQ(L"small test string"_obf, L"small test string");
 }
-#endif
\ No newline at end of file
+#endif
+
+TEST(ObfuscxxTest, Concat) {
+    const auto path = obf_concat("C:\\data\\", 42, '_', -7, ".bin");
+    EXPECT_STREQ(path.to_string().c_str(), "C:\\data\\42_-7.bin");
+    static_assert(decltype(path)::size() == 8 + 11 + 1 + 11 + 4 + 1);
+
+    const auto limits = obf_concat<obf_level::High>(INT64_MIN, ' ', UINT64_MAX, ' ', static_cast<unsigned char>(255),
+                                                    ' ', static_cast<short>(-32768), ' ', true, false, 0);
+    EXPECT_STREQ(limits.to_string().c_str(), "-9223372036854775808 18446744073709551615 255 -32768 truefalse0");
+
+    EXPECT_STREQ(obfusc("endpoint/", 8080, "/v", 2), "endpoint/8080/v2");
+
+#if defined(__clang__) || defined(__GNUC__)
+    const auto joined = obfuscxx("HKEY_LOCAL_MACHINE\\") + obfuscxx("Software");
+    static_assert(decltype(joined)::size() == 28);
+    EXPECT_STREQ(joined.to_string().c_str(), "HKEY_LOCAL_MACHINE\\Software");
+
+    constexpr obfuscxx<char, 5, obf_level::Medium> base{ "base" };
+    EXPECT_STREQ(obf_concat(base, '/', base, 1).to_string().c_str(), "base/base1");
+#endif
+}
+
+TEST(ObfuscxxTest, ArrayFind) {
+    obfuscxx<int, 37> array{ 5, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+                             19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36 };
+
+    EXPECT_EQ(array.find(5).index, 0);
+    EXPECT_EQ(array.find(17).index, 17);
+    EXPECT_EQ(array.find(36).index, 36);
+    EXPECT_EQ(array.find(100), array.end());
+    EXPECT_EQ(*array.find(23), 23);
+}
+
+TEST(ObfuscxxTest, ArrayCount) {
+    obfuscxx<int, 11> array{ 7, 1, 7, 2, 7, 3, 7, 4, 7, 5, 7 };
+
+    EXPECT_EQ(array.count(7), 6);
+    EXPECT_EQ(array.count(3), 1);
+    EXPECT_EQ(array.count(42), 0);
+
+    array.set(7, 1);
+    EXPECT_EQ(array.count(7), 7);
+}
+
+TEST(ObfuscxxTest, ArrayContains) {
+    obfuscxx<std::uint64_t, 6> ids{ 0xDEADBEEF, 0xCAFEBABE, 0x1337, 0xFFFFFFFFFFFFFFFF, 0, 42 };
+
+    EXPECT_TRUE(ids.contains(0xCAFEBABE));
+    EXPECT_TRUE(ids.contains(0xFFFFFFFFFFFFFFFF));
+    EXPECT_TRUE(ids.contains(0));
+    EXPECT_FALSE(ids.contains(0xBADF00D));
+
+    obfuscxx<float, 3> floats{ -1.5f, 0.0f, 2.5f };
+    EXPECT_TRUE(floats.contains(-1.5f));
+    EXPECT_FALSE(floats.contains(1.5f));
+
+    obfuscxx<char, 4> chars{ 'a', 'b', -1, 'd' };
+    EXPECT_TRUE(chars.contains(-1));
+    EXPECT_FALSE(chars.contains('c'));
+}
+
+TEST(ObfuscxxTest, StreamOutput) {
+    std::ostringstream os;
+    os << obfuscxx("stream output longer than one decrypt chunk") << '|' << obfuscxx("") << '|';
+    EXPECT_EQ(os.str(), "stream output longer than one decrypt chunk||");
+
+    std::wostringstream wos;
+    wos << obfuscxx(L"wide stream");
+    EXPECT_EQ(wos.str(), L"wide stream");
+}
+
+TEST(ObfuscxxTest, StreamWidth) {
+    std::ostringstream os;
+    os << std::setw(8) << obfuscxx("abc") << '|' << std::left << std::setfill('.') << std::setw(6) << obfuscxx("de") << '|';
+    EXPECT_EQ(os.str(), "     abc|de....|");
+
+    // The width only applies to one insertion, and is consumed even when the string is longer
+    os.str("");
+    os << std::right << std::setw(2) << obfuscxx("longer") << std::setw(0) << 1 << 2;
+    EXPECT_EQ(os.str(), "longer12");
+}
+
+#if defined(__cpp_lib_format)
+TEST(ObfuscxxTest, FormatOutput) {
+    EXPECT_EQ(std::format("[{}]", obfuscxx("formatted output longer than one chunk")), "[formatted output longer than one chunk]");
+    EXPECT_EQ(std::format(L"[{}]", obfuscxx(L"wide")), L"[wide]");
+}
+
+TEST(ObfuscxxTest, FormatSpecs) {
+    EXPECT_EQ(std::format("[{:>6}]", obfuscxx("abc")), "[   abc]");
+    EXPECT_EQ(std::format("[{:*<5}]", obfuscxx("ab")), "[ab***]");
+    EXPECT_EQ(std::format("[{:.3}]", obfuscxx("truncated")), "[tru]");
+    EXPECT_EQ(std::format(L"[{:^7}]", obfuscxx(L"wide")), L"[ wide  ]");
+    EXPECT_EQ(std::format("[{:>{}.{}s}]", obfuscxx("truncated"), 5, 3), "[  tru]");
+    EXPECT_EQ(std::format("[{:2}]", obfuscxx("longer")), "[longer]");
+}
+#endif
+
+struct object_config {
+    std::int32_t port;
+    float ratio;
+    double limits[4];
+    std::uint64_t id;
+    std::int16_t flags;
+    std::uint8_t level;
+    std::uint8_t mode;
+    std::int32_t retries;
+};
+
+TEST(ObfuscxxTest, ObjectValue) {
+    obfuscxx<object_config> config{ object_config{ 8080, 0.5f, { 1.0, 2.5, -3.25, 1e10 }, 0xDEADBEEFCAFEBABE, -7, 3, 200, 5 } };
+
+    const object_config plain = config.get();
+    EXPECT_EQ(plain.port, 8080);
+    EXPECT_FLOAT_EQ(plain.ratio, 0.5f);
+    EXPECT_DOUBLE_EQ(plain.limits[0], 1.0);
+    EXPECT_DOUBLE_EQ(plain.limits[3], 1e10);
+    EXPECT_EQ(plain.id, 0xDEADBEEFCAFEBABE);
+    EXPECT_EQ(plain.flags, -7);
+    EXPECT_EQ(plain.level, 3);
+    EXPECT_EQ(plain.mode, 200);
+    EXPECT_EQ(plain.retries, 5);
+
+    EXPECT_EQ(config.get<&object_config::port>(), 8080);
+    EXPECT_FLOAT_EQ(config.get<&object_config::ratio>(), 0.5f);
+    EXPECT_EQ(config.get<&object_config::id>(), 0xDEADBEEFCAFEBABE);
+    EXPECT_EQ(config.get<&object_config::flags>(), -7);
+    EXPECT_EQ(config.get<&object_config::mode>(), 200);
+    EXPECT_EQ(config.get<&object_config::retries>(), 5);
+
+    config = object_config{ 443, 1.5f, {}, 1, 2, 3, 4, 5 };
+    EXPECT_EQ(config.get<&object_config::port>(), 443);
+    EXPECT_EQ(config().mode, 4);
+}
+
+TEST(ObfuscxxTest, ObjectIsEncrypted) {
+    struct vec4 { double v[4]; };
+    obfuscxx<vec4> value{ vec4{ 1.0, 2.0, 3.0, 4.0 } };
+
+    const auto* raw_data = reinterpret_cast<const std::uint64_t*>(&value);
+    EXPECT_EQ(sizeof(value), sizeof(vec4));
+    EXPECT_NE(raw_data[0], std::bit_cast<std::uint64_t>(1.0));
+    EXPECT_NE(raw_data[3], std::bit_cast<std::uint64_t>(4.0));
+
+    const vec4 plain = value.get();
+    EXPECT_DOUBLE_EQ(plain.v[0], 1.0);
+    EXPECT_DOUBLE_EQ(plain.v[3], 4.0);
+}
+
+TEST(ObfuscxxTest, ObjectPadding) {
+    // Implicit padding is rejected with a static_assert; the same layout with explicit padding works
+    struct padded { char c; int i; double d; };
+    struct explicit_padding { char c; char pad[3]; int i; double d; };
+    static_assert(!detail::padding_free<padded>);
+    static_assert(detail::padding_free<explicit_padding>);
+    static_assert(detail::padding_free<object_config>);
+
+    // Without a default constructor the probe cannot run, so padding must be ruled out by the type itself
+    struct padded_no_default { char c; int i; padded_no_default(int v) : c{}, i(v) {} };
+    struct packed_no_default { int a; int b; packed_no_default(int v) : a(v), b(v) {} };
+    struct float_no_default { float f; int i; float_no_default(int v) : f{}, i(v) {} };
+    static_assert(!detail::padding_free<padded_no_default>);
+    static_assert(detail::padding_free<packed_no_default>);
+    static_assert(!detail::padding_free<float_no_default>);
+
+    obfuscxx<explicit_padding> value{ explicit_padding{ 'a', {}, 2, 3.0 } };
+    EXPECT_EQ(value.get().c, 'a');
+    EXPECT_EQ(value.get<&explicit_padding::i>(), 2);
+    EXPECT_DOUBLE_EQ(value.get<&explicit_padding::d>(), 3.0);
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(ObfuscxxTest, Int128Value) {
+    const unsigned __int128 expected = (static_cast<unsigned __int128>(0x0123456789ABCDEFULL) << 64) | 0xFEDCBA9876543210ULL;
+    obfuscxx<unsigned __int128> value{ expected };
+    EXPECT_TRUE(value.get() == expected);
+}
+#endif
+
+TEST(ObfuscxxTest, MultiLaneDecrypt) {
+    constexpr std::uint64_t iv[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    constexpr auto schedule = detail::make_xtea_schedule<6>(iv, 0x9E3779B9);
+
+    std::uint64_t plain[37], cipher[37], out[37];
+    for (std::size_t i = 0; i < 37; ++i) {
+        plain[i] = detail::splitmix64(i);
+        cipher[i] = detail::xtea_encrypt_block(plain[i], schedule.keys, 6);
+    }
+
+    for (std::size_t count = 0; count <= 37; ++count) {
+        detail::xtea_decrypt_blocks<6>(cipher, out, count, schedule.keys);
+        for (std::size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(out[i], plain[i]);
+        }
+    }
+}
+
+TEST(ObfuscxxTest, MultiLaneEncrypt) {
+    constexpr std::uint64_t iv[8] = { 8, 7, 6, 5, 4, 3, 2, 1 };
+    constexpr auto schedule = detail::make_xtea_schedule<6>(iv, 0x9E3779B9);
+
+    std::uint64_t plain[37], out[37];
+    for (std::size_t i = 0; i < 37; ++i) {
+        plain[i] = detail::splitmix64(i);
+    }
+
+    for (std::size_t count = 0; count <= 37; ++count) {
+        detail::xtea_encrypt_blocks<6>(plain, out, count, schedule.keys);
+        for (std::size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(out[i], detail::xtea_encrypt_block(plain[i], schedule.keys, 6));
+        }
+    }
+}
+
+template<std::size_t Lanes> void check_generic_kernel() {
+    constexpr std::uint64_t iv[8] = { 3, 1, 4, 1, 5, 9, 2, 6 };
+    constexpr auto schedule = detail::make_xtea_schedule<10>(iv, 0x61C88647);
+
+    std::uint64_t plain[70], cipher[70], out[70];
+    for (std::size_t i = 0; i < 70; ++i) {
+        plain[i] = detail::splitmix64(i * 31);
+    }
+
+    for (std::size_t count : { std::size_t{ 0 }, std::size_t{ 1 }, Lanes - 1, Lanes, Lanes + 3, 2 * Lanes, std::size_t{ 70 } }) {
+        detail::simd::xtea_blocks<Lanes, 10, true>(plain, cipher, count, schedule.keys);
+        detail::simd::xtea_blocks<Lanes, 10, false>(cipher, out, count, schedule.keys);
+        for (std::size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(cipher[i], detail::xtea_encrypt_block(plain[i], schedule.keys, 10));
+            EXPECT_EQ(out[i], plain[i]);
+        }
+    }
+}
+
+TEST(ObfuscxxTest, GenericKernelWidths) {
+    check_generic_kernel<2>();
+    check_generic_kernel<4>();
+    check_generic_kernel<8>();
+    check_generic_kernel<16>();
+    check_generic_kernel<32>();
+}
+
+// Register loaders are not part of OBFUSCXX_LEAN
+#if !defined(OBFUSCXX_LEAN)
+TEST(ObfuscxxTest, LoadDecrypted) {
+    obfuscxx<float, 16> coefficients{ 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f, 13.f, 14.f, 15.f, 16.f };
+    obfuscxx<int, 8> offsets{ -1, -2, -3, -4, -5, -6, -7, -8 };
+    float f[16];
+    int n[16];
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    vst1q_f32(f, coefficients.load_decrypted<4>(4));
+    vst1q_s32(n, offsets.load_decrypted<4>(3));
+#else
+    _mm_storeu_ps(f, coefficients.load_decrypted<4>(4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(n), offsets.load_decrypted<4>(3));
+#endif
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_FLOAT_EQ(f[i], 5.f + i);
+        EXPECT_EQ(n[i], -4 - i);
+    }
+
+#if defined(__AVX2__)
+    _mm256_storeu_ps(f, coefficients.load_decrypted<8>(8));
+    for (int i = 0; i < 8; ++i) EXPECT_FLOAT_EQ(f[i], 9.f + i);
+#endif
+#if defined(__AVX512F__)
+    _mm512_storeu_ps(f, coefficients.load_decrypted<16>(0));
+    for (int i = 0; i < 16; ++i) EXPECT_FLOAT_EQ(f[i], 1.f + i);
+#endif
+}
+#endif
+
+TEST(ObfuscxxTest, SiteEntropy) {
+    static_assert(site_entropy() != site_entropy(1));
+    static_assert(site_entropy() !=
+                  site_entropy());
+
+    obfuscxx<int, 1, obf_level::Low, site_entropy()> value{ 42 };
+    obfuscxx<long long, 4, obf_level::High, site_entropy()> array{ 1LL, -2LL, 3LL, -4LL };
+    EXPECT_EQ(value.get(), 42);
+    EXPECT_EQ(array.get(3), -4);
+}
+
+TEST(ObfuscxxTest, ArrayAssign) {
+    std::array<int, 100> values{};
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i * 7) - 300;
+    }
+
+    obfuscxx<int, 100, obf_level::High> array{};
+    array.assign(values);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(array[i], values[i]);
+    }
+
+    std::array<std::uint64_t, 100> bulk{};
+    std::memcpy(bulk.data(), &array, sizeof(bulk));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        array.set(values[i], i);
+    }
+    EXPECT_EQ(std::memcmp(bulk.data(), &array, sizeof(bulk)), 0);
+}
+
+TEST(ObfuscxxTest, ArraySetRange) {
+    obfuscxx<float, 8> array{ 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f };
+    const float values[] = { -1.f, -2.f, -3.f, -4.f };
+
+    array.set_range(6, values);
+    EXPECT_FLOAT_EQ(array[5], 6.f);
+    EXPECT_FLOAT_EQ(array[6], -1.f);
+    EXPECT_FLOAT_EQ(array[7], -2.f);
+
+    array.set_range(1, std::span{ values, 2 });
+    EXPECT_FLOAT_EQ(array[0], 1.f);
+    EXPECT_FLOAT_EQ(array[1], -1.f);
+    EXPECT_FLOAT_EQ(array[2], -2.f);
+    EXPECT_FLOAT_EQ(array[3], 4.f);
+
+    array.set_range(8, values);
+    EXPECT_FLOAT_EQ(array[7], -2.f);
+}
+
+#if defined(OBFUSCXX_EMBED_TEST_FILE)
+#include "license_asset.h"
+
+TEST(ObfuscxxTest, EmbeddedAsset) {
+    std::ifstream file(OBFUSCXX_EMBED_TEST_FILE, std::ios::binary);
+    const std::string expected{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+    const auto asset = ngu::embedded::license_asset();
+    ASSERT_EQ(asset.size(), expected.size());
+
+    std::string plain(asset.size(), '\0');
+    asset.copy_to(reinterpret_cast<unsigned char*>(plain.data()), asset.size());
+    EXPECT_EQ(plain, expected);
+
+    EXPECT_EQ(asset[13], static_cast<unsigned char>(expected[13]));
+    EXPECT_EQ(asset.get(expected.size() - 1), static_cast<unsigned char>(expected.back()));
+
+    std::string tail(11, '\0');
+    asset.copy_bytes(tail.data(), tail.size(), expected.size() - tail.size());
+    EXPECT_EQ(tail, expected.substr(expected.size() - tail.size()));
+
+    // Reads past the end are clamped to the asset
+    std::string past(32, '#');
+    asset.copy_bytes(past.data(), past.size(), expected.size() - 4);
+    EXPECT_EQ(past.substr(0, 4), expected.substr(expected.size() - 4));
+    EXPECT_EQ(past.substr(4), std::string(28, '#'));
+    asset.copy_bytes(past.data(), past.size(), expected.size() + 100);
+    EXPECT_EQ(past.substr(4), std::string(28, '#'));
+}
+#endif
+
+TEST(ObfuscxxTest, GetAll) {
+    obfuscxx<int> a{ -42 };
+    obfuscxx<float> b{ 1.5f };
+    obfuscxx<double, 1, obf_level::Medium> c{ 3.141592653589793 };
+
+    auto [x, y, z] = get_all(a, b, c);
+    EXPECT_EQ(x, -42);
+    EXPECT_FLOAT_EQ(y, 1.5f);
+    EXPECT_DOUBLE_EQ(z, 3.141592653589793);
+}
+
+TEST(ObfuscxxTest, GetAllMixedLevels) {
+    obfuscxx<int, 1, obf_level::High> v0{ 1 };
+    obfuscxx<std::uint64_t, 1, obf_level::Low> v1{ 0xFFFFFFFFFFFFFFFF };
+    obfuscxx<int8_t, 1, obf_level::Medium> v2{ -127 };
+    obfuscxx<char, 1, obf_level::High> v3{ 'x' };
+    obfuscxx<float, 1, obf_level::High> v4{ -3.14f };
+    obfuscxx<int, 1, obf_level::Low> v5{ INT_MIN };
+    obfuscxx<unsigned, 1, obf_level::Medium> v6{ 7u };
+    obfuscxx<int, 1, obf_level::High> v7{ 8 };
+    obfuscxx<double, 1, obf_level::High> v8{ 1e-300 };
+
+    const auto values = get_all(v0, v1, v2, v3, v4, v5, v6, v7, v8);
+    EXPECT_EQ(std::get<0>(values), 1);
+    EXPECT_EQ(std::get<1>(values), 0xFFFFFFFFFFFFFFFF);
+    EXPECT_EQ(std::get<2>(values), -127);
+    EXPECT_EQ(std::get<3>(values), 'x');
+    EXPECT_FLOAT_EQ(std::get<4>(values), -3.14f);
+    EXPECT_EQ(std::get<5>(values), INT_MIN);
+    EXPECT_EQ(std::get<6>(values), 7u);
+    EXPECT_EQ(std::get<7>(values), 8);
+    EXPECT_DOUBLE_EQ(std::get<8>(values), 1e-300);
+
+    v0 = 100;
+    EXPECT_EQ(std::get<0>(obfuscxx_pack<decltype(v0), decltype(v7)>::get(v0, v7)), 100);
+}
+
+namespace dispatch_test {
+    int add_one(int value) { return value + 1; }
+    int twice(int value) { return value * 2; }
+    int negate(int value) { return -value; }
+
+    struct counter {
+        int step;
+        int advance(int value) { return value + step; }
+        int rewind(int value) const { return value - step; }
+    };
+}
+
+TEST(ObfuscxxTest, DispatchTable) {
+    using namespace dispatch_test;
+    obfuscated_dispatch_table<int(int), 3> table{ &add_one, &twice, &negate };
+
+    EXPECT_FALSE(table.is_protected());
+    EXPECT_EQ(table(0, 41), 42);
+    EXPECT_EQ(table(1, 21), 42);
+    EXPECT_EQ(table[2], &negate);
+
+    table.set(2, &add_one);
+    EXPECT_EQ(table(2, 1), 2);
+
+    obfuscxx<int(*)(int), 3> encrypted{};
+    encrypted = { &negate, &twice, &add_one };
+    obfuscated_dispatch_table<int(int), 3> from_encrypted{ encrypted };
+    EXPECT_EQ(from_encrypted(0, 5), -5);
+    EXPECT_EQ(from_encrypted(2, 5), 6);
+
+    obfuscxx<int(*)(int), 3, obf_level::High> encrypted_high{};
+    encrypted_high = { &twice, &twice, &negate };
+    obfuscated_dispatch_table<int(int), 3, dispatch_mode::decrypted> from_high{ encrypted_high };
+    EXPECT_EQ(from_high(1, 4), 8);
+
+    static_assert(!std::is_constructible_v<obfuscated_dispatch_table<int(int), 1>, const obfuscxx<int(*)(int), 1>&>);
+}
+
+TEST(ObfuscxxTest, DispatchTableDecrypted) {
+    using namespace dispatch_test;
+    obfuscated_dispatch_table<int(int), 3, dispatch_mode::decrypted, obf_level::High> table{ &add_one, &twice, &negate };
+
+    EXPECT_TRUE(table.is_protected());
+    EXPECT_EQ(table(0, 1), 2);
+    EXPECT_EQ(table(2, 7), -7);
+
+    table.set(1, &negate);
+    EXPECT_EQ(table(1, 3), -3);
+
+    auto moved = std::move(table);
+    EXPECT_TRUE(moved.is_protected());
+    EXPECT_FALSE(table.is_protected());
+    EXPECT_EQ(moved(0, 9), 10);
+}
+
+TEST(ObfuscxxTest, DispatchMemberThunks) {
+    using namespace dispatch_test;
+    counter c{ 10 };
+
+    obfuscated_dispatch_table<int(counter&, int), 1> advance{ member_thunk<&counter::advance> };
+    obfuscated_dispatch_table<int(const counter&, int), 1, dispatch_mode::decrypted> rewind{ member_thunk<&counter::rewind> };
+
+    EXPECT_EQ(advance(0, c, 5), 15);
+    EXPECT_EQ(rewind(0, c, 5), -5);
+}
+
+TEST(ObfuscxxTest, RotatingValues) {
+    std::array<int, 300> values{};
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>(i * 13) - 1000;
+
+    auto array = std::make_unique<obfuscxx_rotating<int, 300, obf_level::Medium, 32>>(values);
+    EXPECT_EQ(array->generation(), 0u);
+    EXPECT_FALSE(array->rotating());
+
+    array->rotate(4);
+    EXPECT_EQ(array->generation(), 1u);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(array->get(i), values[i]);
+    }
+
+    array->set(299, 7);
+    std::array<int, 300> copy{};
+    array->copy_to(copy.data(), copy.size());
+    EXPECT_EQ(copy[299], 7);
+    EXPECT_EQ(copy[0], values[0]);
+}
+
+TEST(ObfuscxxTest, RotatingMidRotation) {
+    std::array<double, 100> values{};
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<double>(i) / 3.0;
+
+    obfuscxx_rotating<double, 100, obf_level::High, 16> array{ values };
+
+    ASSERT_TRUE(array.begin_rotation());
+    EXPECT_FALSE(array.begin_rotation());
+    EXPECT_FALSE(array.rotate_step(3));
+    EXPECT_TRUE(array.rotating());
+
+    // Rotated and pending chunks both decrypt, and values set mid-rotation land under the right key
+    array.set(10, -1.0);
+    array.set(90, -2.0);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const double expected = (i == 10) ? -1.0 : (i == 90) ? -2.0 : values[i];
+        EXPECT_DOUBLE_EQ(array[i], expected);
+    }
+
+    EXPECT_TRUE(array.rotate_step(100));
+    EXPECT_DOUBLE_EQ(array[90], -2.0);
+    EXPECT_DOUBLE_EQ(array[99], values[99]);
+}
+
+TEST(ObfuscxxTest, RotatingBackground) {
+    std::array<std::uint32_t, 4096> values{};
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<std::uint32_t>(i * 2654435761u);
+
+    auto array = std::make_unique<obfuscxx_rotating<std::uint32_t, 4096, obf_level::Low>>(values);
+    array->start_background_rotation(std::chrono::milliseconds(0), 2);
+
+    std::size_t mismatches = 0;
+    for (int pass = 0; pass < 200 || array->generation() < 2; ++pass) {
+        for (std::size_t i = 0; i < values.size(); i += 7) {
+            mismatches += array->get(i) != values[i];
+        }
+    }
+    array->stop_background_rotation();
+
+    EXPECT_EQ(mismatches, 0u);
+    EXPECT_GE(array->generation(), 2u);
+}
+
+TEST(ObfuscxxTest, BufferAppendAndResize) {
+    obfuscxx_buffer<std::uint16_t> buffer;
+    EXPECT_TRUE(buffer.empty());
+
+    // Appends of odd lengths keep splitting blocks, so every tail merge is exercised
+    std::vector<std::uint16_t> values;
+    for (std::size_t n = 1; values.size() < 300; n += 3) {
+        std::vector<std::uint16_t> part(n);
+        for (auto &v : part) v = static_cast<std::uint16_t>(values.size() * 7 + (&v - part.data()));
+        buffer.append(part);
+        values.insert(values.end(), part.begin(), part.end());
+    }
+    buffer.push_back(0xBEEF);
+    values.push_back(0xBEEF);
+
+    ASSERT_EQ(buffer.size(), values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(buffer[i], values[i]);
+    }
+
+    std::vector<std::uint16_t> copy(values.size() - 5);
+    buffer.copy_to(copy.data(), copy.size(), 5);
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), values.begin() + 5));
+
+    buffer.set(101, 0x1234);
+    EXPECT_EQ(buffer[100], values[100]);
+    EXPECT_EQ(buffer[101], 0x1234);
+    EXPECT_EQ(buffer[102], values[102]);
+
+    // Shrinking then growing back must not resurrect the cut-off values
+    buffer.resize(99);
+    buffer.resize(110);
+    EXPECT_EQ(buffer[98], values[98]);
+    for (std::size_t i = 99; i < 110; ++i) {
+        EXPECT_EQ(buffer[i], 0);
+    }
+}
+
+TEST(ObfuscxxTest, BufferBounds) {
+    obfuscxx_buffer<int> buffer;
+    buffer.push_back(1);
+    buffer.reserve(1000);
+
+    // Setting past the end zero-fills the gap, even over reserved but never written blocks
+    buffer.set(500, 7);
+    ASSERT_EQ(buffer.size(), 501u);
+    EXPECT_EQ(buffer[0], 1);
+    for (std::size_t i = 1; i < 500; ++i) {
+        EXPECT_EQ(buffer[i], 0);
+    }
+    EXPECT_EQ(buffer[500], 7);
+
+    // Reads stop at size()
+    std::vector<int> out(buffer.size() + 100, -1);
+    buffer.copy_to(out.data(), out.size());
+    EXPECT_EQ(out[500], 7);
+    EXPECT_EQ(out[501], -1);
+    EXPECT_EQ(out.back(), -1);
+
+    buffer.copy_to(out.data(), 10, buffer.size() + 5);
+    EXPECT_EQ(out[0], 1);
+}
+
+TEST(ObfuscxxTest, BufferCiphertext) {
+    std::vector<std::uint64_t> values(1000, 0x4141414141414141ULL);
+
+    obfuscxx_buffer<std::uint64_t, obf_level::High> a{ values };
+    obfuscxx_buffer<std::uint64_t, obf_level::High> b{ values };
+
+    // Per-instance nonce: equal plaintext under two buffers gives different ciphertext
+    ASSERT_EQ(a.ciphertext().size(), values.size());
+    EXPECT_FALSE(std::equal(a.ciphertext().begin(), a.ciphertext().end(), b.ciphertext().begin()));
+    EXPECT_EQ(std::count(a.ciphertext().begin(), a.ciphertext().end(), values[0]), 0);
+
+    // Appending past the capacity moves the existing ciphertext instead of re-encrypting it
+    const std::vector<std::uint64_t> before(a.ciphertext().begin(), a.ciphertext().end());
+    a.append(values);
+    EXPECT_TRUE(std::equal(before.begin(), before.end(), a.ciphertext().begin()));
+    EXPECT_EQ(a.size(), 2000u);
+
+    obfuscxx_buffer<std::uint64_t, obf_level::High> moved{ std::move(a) };
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(moved[1999], values[0]);
+}
+
+TEST(ObfuscxxTest, BufferObjects) {
+    struct entry {
+        std::uint32_t id;
+        float weight;
+        char tag[5];
+    };
+
+    obfuscxx_buffer<entry, obf_level::Low> buffer;
+    for (std::uint32_t i = 0; i < 50; ++i) {
+        buffer.push_back({ i, static_cast<float>(i) * 0.5f, { 't', static_cast<char>('a' + i % 26) } });
+    }
+
+    const entry e = buffer[37];
+    EXPECT_EQ(e.id, 37u);
+    EXPECT_FLOAT_EQ(e.weight, 18.5f);
+    EXPECT_EQ(e.tag[1], 'a' + 37 % 26);
+}
+
+namespace view_test {
+    // obfuscxx_test and its outline, lean and generic-SIMD variants run concurrently under ctest -j,
+    // so every process writes its own files
+    inline std::string temp_path(const char *name) {
+        return (std::filesystem::temp_directory_path() /
+                (std::string(name) + '_' + std::to_string(detail::runtime_nonce()) + ".obft")).string();
+    }
+}
+
+TEST(ObfuscxxTest, ViewRoundTrip) {
+    std::vector<double> values(10000);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<double>(i % 977) * 0.25;
+
+    const std::string path = view_test::temp_path("obfuscxx_view_round_trip");
+    ASSERT_TRUE((write_obfuscxx_table<obf_level::High, 0x1234>(path.c_str(), values.data(), values.size())));
+
+    obfuscxx_view<double, obf_level::High, 0x1234> view{ path.c_str() };
+    ASSERT_TRUE(view.is_open());
+    ASSERT_EQ(view.size(), values.size());
+    EXPECT_DOUBLE_EQ(view[0], values[0]);
+    EXPECT_DOUBLE_EQ(view.get(9999), values[9999]);
+
+    std::vector<double> copy(values.size() - 3);
+    view.copy_to(copy.data(), copy.size(), 3);
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), values.begin() + 3));
+
+    // copy_to stops at size()
+    std::vector<double> tail(100, -1.0);
+    view.copy_to(tail.data(), tail.size(), values.size() - 10);
+    EXPECT_DOUBLE_EQ(tail[9], values.back());
+    EXPECT_DOUBLE_EQ(tail[10], -1.0);
+    view.copy_to(tail.data(), tail.size(), values.size() + 10);
+    EXPECT_DOUBLE_EQ(tail[0], values[values.size() - 10]);
+
+    std::size_t visited = 0;
+    for (double v : view) visited += v == values[visited];
+    EXPECT_EQ(visited, values.size());
+
+    EXPECT_EQ(view.find(values[500]).index, 500u);
+    EXPECT_EQ(view.count(values[500]), static_cast<std::size_t>(std::count(values.begin(), values.end(), values[500])));
+    EXPECT_FALSE(view.contains(-1.0));
+    EXPECT_EQ(std::count(view.ciphertext().begin(), view.ciphertext().end(), std::bit_cast<std::uint64_t>(values[1])), 0);
+
+    // Rewriting the table replaces the file: the open view keeps the old contents until it reopens
+    std::vector<double> updated(values.size() / 2, 3.5);
+    ASSERT_TRUE((write_obfuscxx_table<obf_level::High, 0x1234>(path.c_str(), updated.data(), updated.size())));
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+    EXPECT_EQ(view.size(), values.size());
+    EXPECT_DOUBLE_EQ(view.get(9999), values[9999]);
+    ASSERT_TRUE(view.open(path.c_str()));
+    EXPECT_EQ(view.size(), updated.size());
+    EXPECT_DOUBLE_EQ(view[0], 3.5);
+
+    // Another seed, level or element type does not open the file
+    EXPECT_FALSE((obfuscxx_view<double, obf_level::High, 0x1235>{ path.c_str() }.is_open()));
+    EXPECT_FALSE((obfuscxx_view<double, obf_level::Medium, 0x1234>{ path.c_str() }.is_open()));
+    EXPECT_FALSE((obfuscxx_view<float, obf_level::High, 0x1234>{ path.c_str() }.is_open()));
+
+    view.close();
+    std::filesystem::remove(path);
+}
+
+TEST(ObfuscxxTest, ViewObjects) {
+    struct record {
+        std::uint64_t id;
+        std::int32_t score;
+        char tag[8];
+    };
+
+    std::vector<record> values(300);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = { i * 31, -static_cast<std::int32_t>(i), { 'r', static_cast<char>('a' + i % 26) } };
+
+    const std::string path = view_test::temp_path("obfuscxx_view_objects");
+    ASSERT_TRUE((write_obfuscxx_table<obf_level::Low, 42>(path.c_str(), values.data(), values.size())));
+
+    obfuscxx_view<record, obf_level::Low, 42> view;
+    ASSERT_TRUE(view.open(path.c_str()));
+    obfuscxx_view<record, obf_level::Low, 42> moved{ std::move(view) };
+    EXPECT_FALSE(view.is_open());
+
+    const record r = moved[123];
+    EXPECT_EQ(r.id, 123u * 31);
+    EXPECT_EQ(r.score, -123);
+    EXPECT_EQ(r.tag[1], 'a' + 123 % 26);
+
+    std::vector<record> copy(values.size());
+    moved.copy_to(copy.data(), copy.size());
+    EXPECT_EQ(copy[299].id, values[299].id);
+    EXPECT_EQ(copy[64].score, values[64].score);
+
+    moved.close();
+    std::filesystem::remove(path);
+}
+
+TEST(ObfuscxxTest, ViewSignedLayout) {
+    std::vector<std::int16_t> values(200);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<std::int16_t>(static_cast<int>(i) * 331 - 30000);
+
+    // write_obfuscxx_table widens elements like obfuscxx arrays: the plaintext blocks are to_block values
+    const std::string path = view_test::temp_path("obfuscxx_view_signed");
+    ASSERT_TRUE((write_obfuscxx_table<obf_level::Medium, 7>(path.c_str(), values.data(), values.size())));
+
+    obfuscxx_view<std::int16_t, obf_level::Medium, 7> view{ path.c_str() };
+    ASSERT_TRUE(view.is_open());
+
+    detail::table_header header;
+    std::ifstream(path, std::ios::binary).read(reinterpret_cast<char*>(&header), sizeof(header));
+    std::uint32_t keys[detail::xtea_max_rounds * 2];
+    detail::table_keys(7, header.nonce, obf_level::Medium, keys);
+    EXPECT_EQ(header.flags, detail::table_sign_extended);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(detail::xtea_decrypt_block(view.ciphertext()[i], keys, detail::table_rounds(obf_level::Medium)), detail::to_block(values[i]));
+    }
+    EXPECT_EQ(view.find(values[3]).index, 3u);
+    EXPECT_EQ(view.get(3), values[3]);
+
+    // A zero-extended table, as obfuscxx_table writes without --signed, still matches negative needles
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    {
+        detail::table_writer writer(file, sizeof(std::int16_t), obf_level::Medium, 7, 99);
+        ASSERT_TRUE(writer.write(values.data(), values.size()) && writer.finish());
+    }
+    std::fclose(file);
+
+    obfuscxx_view<std::int16_t, obf_level::Medium, 7> zero_extended{ path.c_str() };
+    ASSERT_TRUE(zero_extended.is_open());
+    EXPECT_EQ(zero_extended.find(values[3]).index, 3u);
+    EXPECT_EQ(zero_extended.count(values[150]), 1u);
+    EXPECT_EQ(zero_extended.get(3), values[3]);
+
+    view.close();
+    zero_extended.close();
+    std::filesystem::remove(path);
+}
+
+#if defined(OBFUSCXX_TABLE_TEST_FILE)
+TEST(ObfuscxxTest, ViewTableFile) {
+    std::ifstream file(OBFUSCXX_EMBED_TEST_FILE, std::ios::binary);
+    const std::string expected{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+    // Written at build time by obfuscxx_table --element-size 1 --level Medium --seed 0x5eed
+    obfuscxx_view<char, obf_level::Medium, 0x5eed> view{ OBFUSCXX_TABLE_TEST_FILE };
+    ASSERT_TRUE(view.is_open());
+    ASSERT_EQ(view.size(), expected.size());
+
+    std::string plain(view.size(), '\0');
+    view.copy_to(plain.data(), plain.size());
+    EXPECT_EQ(plain, expected);
+    EXPECT_EQ(view.count('\n'), static_cast<std::size_t>(std::count(expected.begin(), expected.end(), '\n')));
+}
+#endif
@@ -0,0 +1,39 @@
+// obfuscxx – ngu.obfuscxx module interface
+// SPDX-FileCopyrightText: 2025-2026 Alexander (nevergiveup-c)
+// SPDX-License-Identifier: MIT
+//
+// Built on the lean header, so importers never parse the intrinsic headers; link the obfuscxx_lean
+// library for the kernels. Macros do not cross module boundaries: OBFUSCXX_ENTROPY, obfusv and obfuss
+// are header-only, importers pass ngu::site_entropy() as the Entropy argument instead.
+
+module;
+
+// Every standard header obfuscxx.h and obfuscxx_format.h include goes into the global module
+// fragment, so the include guards keep them out of the purview below
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iosfwd>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <version>
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+export module ngu.obfuscxx;
+
+// Exported as declared rather than through using-declarations, which GCC 12 does not re-export for
+// class templates
+export extern "C++" {
+#include "include/obfuscxx_lean.h"
+}
+
+// The std::formatter specialization is not exported, importers still reach it through std::format
+#if defined(__cpp_lib_format)
+extern "C++" {
+#include "include/obfuscxx_format.h"
+}
+#endif
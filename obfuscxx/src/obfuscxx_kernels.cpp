@@ -0,0 +1,53 @@
+// obfuscxx – out-of-line kernels for OBFUSCXX_LEAN translation units
+// SPDX-FileCopyrightText: 2025-2026 Alexander (nevergiveup-c)
+// SPDX-License-Identifier: MIT
+//
+// The only translation unit of the obfuscxx_lean library that sees the intrinsic headers. Every round
+// count make_xtea_key can produce (and the even counts in between) runs the same kernels as the header
+// mode, compiled for the ISA flags of this library; anything else takes the scalar reference.
+
+#if defined(OBFUSCXX_LEAN)
+#error obfuscxx_kernels.cpp must be compiled without OBFUSCXX_LEAN
+#endif
+
+#include "include/obfuscxx.h"
+
+namespace ngu::detail {
+    namespace {
+        template<std::uint32_t Rounds = 2, class Kernel, class Fallback>
+        OBFUSCXX_FORCEINLINE auto with_rounds(std::uint32_t rounds, Kernel &&kernel, Fallback &&fallback) {
+            if constexpr (Rounds > xtea_max_rounds) {
+                return fallback();
+            } else {
+                if (rounds == Rounds) return kernel.template operator()<Rounds>();
+                return with_rounds<Rounds + 2>(rounds, kernel, fallback);
+            }
+        }
+    }
+
+    extern "C" std::uint64_t ngu_obfuscxx_decrypt(std::uint64_t value, const std::uint32_t *keys, std::uint32_t rounds) {
+        return with_rounds(rounds,
+            [&]<std::uint32_t Rounds>() { return xtea_decrypt_outlined<Rounds>(value, keys); },
+            [&]() { return xtea_decrypt_block(value, keys, rounds); });
+    }
+
+    extern "C" void ngu_obfuscxx_decrypt_blocks(const std::uint64_t *in, std::uint64_t *out, std::size_t count, const std::uint32_t *keys, std::uint32_t rounds) {
+        with_rounds(rounds,
+            [&]<std::uint32_t Rounds>() { xtea_decrypt_blocks<Rounds>(in, out, count, keys); },
+            [&]() { for (std::size_t i = 0; i < count; ++i) out[i] = xtea_decrypt_block(in[i], keys, rounds); });
+    }
+
+    extern "C" void ngu_obfuscxx_encrypt_blocks(const std::uint64_t *in, std::uint64_t *out, std::size_t count, const std::uint32_t *keys, std::uint32_t rounds) {
+        with_rounds(rounds,
+            [&]<std::uint32_t Rounds>() { xtea_encrypt_blocks<Rounds>(in, out, count, keys); },
+            [&]() { for (std::size_t i = 0; i < count; ++i) out[i] = xtea_encrypt_block(in[i], keys, rounds); });
+    }
+
+    extern "C" std::size_t ngu_obfuscxx_find_u64(const std::uint64_t *data, std::size_t size, std::uint64_t needle) {
+        return find_u64(data, size, needle);
+    }
+
+    extern "C" std::size_t ngu_obfuscxx_count_u64(const std::uint64_t *data, std::size_t size, std::uint64_t needle) {
+        return count_u64(data, size, needle);
+    }
+}
@@ -0,0 +1,257 @@
+// obfuscxx – build-time asset encryption
+// SPDX-FileCopyrightText: 2025-2026 Alexander (nevergiveup-c)
+// SPDX-License-Identifier: MIT
+//
+// Encrypts a file with the obfuscxx key derivation and emits <name>.h exposing it as
+// ngu::embedded::<name>(), an ngu::embedded_asset<Type, Level, Entropy>. The ciphertext is never
+// spelled out as C++: by default it goes to <name>.bin, pulled in by a <name>.cpp stub with .incbin
+// (GCC, Clang), and with --coff <machine> straight into a <name>.obj COFF object (MSVC).
+//
+// usage: obfuscxx_embed <input> <output_dir> <name> [--type <type>] [--level Low|Medium|High] [--seed <integer>]
+//                       [--coff x64|x86|arm64]
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "include/obfuscxx.h"
+
+using namespace ngu;
+
+namespace {
+    bool is_identifier(const std::string &name) {
+        if (name.empty() || (name[0] >= '0' && name[0] <= '9')) return false;
+        for (char c : name) {
+            if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_')) return false;
+        }
+        return true;
+    }
+
+    bool parse_level(const std::string &text, obf_level &level) {
+        if (text == "Low") level = obf_level::Low;
+        else if (text == "Medium") level = obf_level::Medium;
+        else if (text == "High") level = obf_level::High;
+        else return false;
+        return true;
+    }
+
+    bool parse_integer(const std::string &text, std::uint64_t &value) {
+        try {
+            std::size_t used = 0;
+            value = std::stoull(text, &used, 0);
+            return used == text.size();
+        } catch (const std::logic_error&) {
+            return false;
+        }
+    }
+
+    bool parse_machine(std::string text, std::uint16_t &machine) {
+        for (char &c : text) {
+            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        }
+        if (text == "x64" || text == "amd64") machine = 0x8664;
+        else if (text == "x86") machine = 0x14c;
+        else if (text == "arm64") machine = 0xaa64;
+        else return false;
+        return true;
+    }
+
+    std::filesystem::path path_with(const std::filesystem::path &base, const char *extension) {
+        std::filesystem::path path = base;
+        path += extension;
+        return path;
+    }
+
+    // Quotes a path for an assembler string that itself sits in a C++ string literal
+    std::string escape_path(const std::filesystem::path &path) {
+        std::string escaped;
+        for (char c : path.generic_string()) {
+            if (c == '\\') escaped += "\\\\\\\\";
+            else if (c == '"') escaped += "\\\\\\\"";
+            else escaped += c;
+        }
+        return escaped;
+    }
+
+    template<class Type> void put(std::ofstream &out, Type value) {
+        for (std::size_t i = 0; i < sizeof(Type); ++i) {
+            out.put(static_cast<char>((static_cast<std::uint64_t>(value) >> (i * 8)) & 0xff));
+        }
+    }
+
+    // Minimal COFF object: one read-only, 64-byte aligned .rdata section holding the blob and one
+    // external symbol at its start. The timestamp is zero so reproducible builds stay byte-identical
+    bool write_coff(const std::filesystem::path &path, const std::vector<unsigned char> &blob, const std::string &symbol, std::uint16_t machine) {
+        if (blob.size() > 0x7fffffffu) return false;
+
+        // 32-bit x86 decorates C names with a leading underscore
+        const std::string decorated = (machine == 0x14c ? "_" : "") + symbol;
+
+        constexpr std::uint32_t header_size = 20, section_header_size = 40;
+        const auto raw_size = static_cast<std::uint32_t>(blob.size());
+        const std::uint32_t symbol_table = header_size + section_header_size + raw_size;
+
+        std::ofstream out(path, std::ios::binary);
+        put<std::uint16_t>(out, machine);
+        put<std::uint16_t>(out, 1);             // NumberOfSections
+        put<std::uint32_t>(out, 0);             // TimeDateStamp
+        put<std::uint32_t>(out, symbol_table);  // PointerToSymbolTable
+        put<std::uint32_t>(out, 1);             // NumberOfSymbols
+        put<std::uint16_t>(out, 0);             // SizeOfOptionalHeader
+        put<std::uint16_t>(out, 0);             // Characteristics
+
+        out.write(".rdata\0\0", 8);
+        put<std::uint32_t>(out, 0);             // VirtualSize
+        put<std::uint32_t>(out, 0);             // VirtualAddress
+        put<std::uint32_t>(out, raw_size);      // SizeOfRawData
+        put<std::uint32_t>(out, header_size + section_header_size);
+        put<std::uint32_t>(out, 0);             // PointerToRelocations
+        put<std::uint32_t>(out, 0);             // PointerToLinenumbers
+        put<std::uint16_t>(out, 0);             // NumberOfRelocations
+        put<std::uint16_t>(out, 0);             // NumberOfLinenumbers
+        put<std::uint32_t>(out, 0x40000040u | 0x00700000u);  // initialized data, read-only, 64-byte aligned
+
+        out.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+
+        // The symbol name always goes through the string table, which starts with its own size
+        put<std::uint32_t>(out, 0);
+        put<std::uint32_t>(out, 4);
+        put<std::uint32_t>(out, 0);             // Value
+        put<std::int16_t>(out, 1);              // SectionNumber
+        put<std::uint16_t>(out, 0);             // Type
+        put<std::uint8_t>(out, 2);              // IMAGE_SYM_CLASS_EXTERNAL
+        put<std::uint8_t>(out, 0);              // NumberOfAuxSymbols
+
+        put<std::uint32_t>(out, static_cast<std::uint32_t>(4 + decorated.size() + 1));
+        out.write(decorated.c_str(), static_cast<std::streamsize>(decorated.size() + 1));
+        return static_cast<bool>(out);
+    }
+
+    int usage() {
+        std::cerr << "usage: obfuscxx_embed <input> <output_dir> <name> [--type <type>] [--level Low|Medium|High] [--seed <integer>]\n"
+                  << "                      [--coff x64|x86|arm64]\n";
+        return 2;
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 4) return usage();
+
+    const std::string input = argv[1];
+    const std::string output_dir = argv[2];
+    const std::string name = argv[3];
+
+    std::string type = "unsigned char";
+    std::string level_name = "Low";
+    obf_level level = obf_level::Low;
+    std::uint16_t machine = 0;
+    std::uint64_t seed = (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+
+    for (int i = 4; i < argc; i += 2) {
+        const std::string option = argv[i];
+        if (i + 1 >= argc) return usage();
+
+        if (option == "--type") {
+            type = argv[i + 1];
+        } else if (option == "--level") {
+            level_name = argv[i + 1];
+            if (!parse_level(level_name, level)) return usage();
+        } else if (option == "--seed") {
+            if (!parse_integer(argv[i + 1], seed)) return usage();
+        } else if (option == "--coff") {
+            if (!parse_machine(argv[i + 1], machine)) return usage();
+        } else {
+            return usage();
+        }
+    }
+
+    if (!is_identifier(name)) {
+        std::cerr << "obfuscxx_embed: '" << name << "' is not a valid identifier\n";
+        return 1;
+    }
+
+    std::ifstream file(input, std::ios::binary);
+    if (!file) {
+        std::cerr << "obfuscxx_embed: cannot open " << input << '\n';
+        return 1;
+    }
+    const std::vector<unsigned char> payload{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+    // Same derivation as obfuscxx<..., Level, Entropy>; the asset name keeps several embeds apart
+    const std::uint64_t entropy = detail::splitmix64(seed ^ detail::hash_runtime(name.c_str()));
+    const detail::xtea_key key = detail::make_xtea_key(entropy, level);
+    std::uint32_t keys[detail::xtea_max_rounds * 2]{};
+    detail::fill_xtea_keys(key.iv, key.delta, key.rounds, keys);
+
+    const std::size_t block_count = payload.empty() ? 1 : (payload.size() + 7) / 8;
+    // Blocks are stored little-endian, the layout the linked std::uint64_t array is read with
+    std::vector<unsigned char> blob(block_count * 8);
+    for (std::size_t b = 0; b < block_count; ++b) {
+        std::uint64_t block = 0;
+        for (std::size_t j = 0; j < 8 && b * 8 + j < payload.size(); ++j) {
+            block |= static_cast<std::uint64_t>(payload[b * 8 + j]) << (j * 8);
+        }
+
+        block = detail::xtea_encrypt_block(block, keys, key.rounds);
+        for (std::size_t j = 0; j < 8; ++j) {
+            blob[b * 8 + j] = static_cast<unsigned char>(block >> (j * 8));
+        }
+    }
+
+    const std::string symbol = "ngu_embedded_" + name + "_blocks";
+    const std::filesystem::path base = std::filesystem::absolute(std::filesystem::path(output_dir) / name);
+    bool written;
+
+    if (machine) {
+        written = write_coff(path_with(base, ".obj"), blob, symbol, machine);
+    } else {
+        std::ofstream data(path_with(base, ".bin"), std::ios::binary);
+        data.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+
+        std::ofstream source(path_with(base, ".cpp"), std::ios::binary);
+        source << "// Generated by obfuscxx_embed, do not edit\n"
+               << "// The ciphertext is linked from " << name << ".bin as is, so compiling this stub does not\n"
+               << "// depend on the size of the asset\n"
+               << "#define NGU_EMBED_STR2(x) #x\n"
+               << "#define NGU_EMBED_STR(x) NGU_EMBED_STR2(x)\n\n"
+               << "#if defined(__APPLE__)\n"
+               << "#define NGU_EMBED_SECTION \"__TEXT,__const\"\n"
+               << "#elif defined(_WIN32)\n"
+               << "#define NGU_EMBED_SECTION \".rdata,\\\"dr\\\"\"\n"
+               << "#else\n"
+               << "#define NGU_EMBED_SECTION \".rodata\"\n"
+               << "#endif\n"
+               << "#define NGU_EMBED_SYMBOL NGU_EMBED_STR(__USER_LABEL_PREFIX__) \"" << symbol << "\"\n\n"
+               << "__asm__(\".section \" NGU_EMBED_SECTION \"\\n\"\n"
+               << "        \".balign 64\\n\"\n"
+               << "        \".globl \" NGU_EMBED_SYMBOL \"\\n\"\n"
+               << "        NGU_EMBED_SYMBOL \":\\n\"\n"
+               << "        \".incbin \\\"" << escape_path(path_with(base, ".bin")) << "\\\"\\n\"\n"
+               << "        \".text\\n\");\n";
+
+        written = data && source;
+    }
+
+    std::ofstream header(path_with(base, ".h"), std::ios::binary);
+    header << "// Generated by obfuscxx_embed, do not edit\n"
+           << "#pragma once\n"
+           << "#include \"include/obfuscxx.h\"\n\n"
+           << "namespace ngu::embedded {\n"
+           << "    extern \"C\" const std::uint64_t " << symbol << "[" << block_count << "];\n\n"
+           << "    inline ngu::embedded_asset<" << type << ", ngu::obf_level::" << level_name << ", " << entropy << "ULL> " << name << "() {\n"
+           << "        return { " << symbol << ", " << payload.size() << " };\n"
+           << "    }\n"
+           << "}\n";
+
+    if (!written || !header) {
+        std::cerr << "obfuscxx_embed: cannot write to " << output_dir << '\n';
+        return 1;
+    }
+    return 0;
+}
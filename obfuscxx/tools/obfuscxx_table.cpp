@@ -0,0 +1,149 @@
+// obfuscxx – encrypted table file writer
+// SPDX-FileCopyrightText: 2025-2026 Alexander (nevergiveup-c)
+// SPDX-License-Identifier: MIT
+//
+// Encrypts a file of fixed-size elements into a table file for ngu::obfuscxx_view<Type, Level, Seed>,
+// where sizeof(Type) is the element size. Without --seed a random one is drawn and printed, the reader
+// needs it as its Seed argument. Elements narrower than 8 bytes are zero-extended into their block;
+// --signed sign-extends them instead, the obfuscxx layout of signed integers and enums (and of char
+// where it is signed), so that find/count on the view match obfuscxx arrays of that type.
+//
+// usage: obfuscxx_table <input> <output> [--element-size <bytes>] [--level Low|Medium|High] [--seed <integer>] [--signed]
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "include/obfuscxx_view.h"
+
+using namespace ngu;
+
+namespace {
+    bool parse_level(const std::string &text, obf_level &level) {
+        if (text == "Low") level = obf_level::Low;
+        else if (text == "Medium") level = obf_level::Medium;
+        else if (text == "High") level = obf_level::High;
+        else return false;
+        return true;
+    }
+
+    bool parse_integer(const std::string &text, std::uint64_t &value) {
+        try {
+            std::size_t used = 0;
+            value = std::stoull(text, &used, 0);
+            return used == text.size();
+        } catch (const std::logic_error&) {
+            return false;
+        }
+    }
+
+    int usage() {
+        std::cerr << "usage: obfuscxx_table <input> <output> [--element-size <bytes>] [--level Low|Medium|High] [--seed <integer>] [--signed]\n";
+        return 2;
+    }
+
+    struct file_closer {
+        void operator()(std::FILE *file) const { std::fclose(file); }
+    };
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) return usage();
+
+    const std::string input = argv[1];
+    const std::string output = argv[2];
+
+    std::uint32_t element_size = 8;
+    obf_level level = obf_level::Medium;
+    bool has_seed = false;
+    bool sign_extend = false;
+    std::uint64_t seed = 0;
+
+    for (int i = 3; i < argc; i += 2) {
+        const std::string option = argv[i];
+        if (option == "--signed") {
+            sign_extend = true;
+            --i;
+            continue;
+        }
+        if (i + 1 >= argc) return usage();
+
+        if (option == "--element-size") {
+            std::uint64_t size = 0;
+            if (!parse_integer(argv[i + 1], size) || size > detail::table_writer::max_element_size) return usage();
+            element_size = static_cast<std::uint32_t>(size);
+        } else if (option == "--level") {
+            if (!parse_level(argv[i + 1], level)) return usage();
+        } else if (option == "--seed") {
+            if (!parse_integer(argv[i + 1], seed)) return usage();
+            has_seed = true;
+        } else {
+            return usage();
+        }
+    }
+
+    if (element_size == 0 || element_size > detail::table_writer::max_element_size) {
+        std::cerr << "obfuscxx_table: element size must be 1.." << detail::table_writer::max_element_size << " bytes\n";
+        return 1;
+    }
+
+    std::random_device device;
+    if (!has_seed) {
+        seed = (static_cast<std::uint64_t>(device()) << 32) | device();
+        std::cout << "seed: 0x" << std::hex << seed << std::dec << '\n';
+    }
+    const std::uint64_t nonce = (static_cast<std::uint64_t>(device()) << 32) | device();
+
+    std::unique_ptr<std::FILE, file_closer> in(std::fopen(input.c_str(), "rb"));
+    if (!in) {
+        std::cerr << "obfuscxx_table: cannot open " << input << '\n';
+        return 1;
+    }
+
+    // Written next to the output and moved over it at the end, so processes mapping the old table
+    // keep reading it until they reopen instead of seeing it truncated
+    const std::string temporary = output + ".tmp";
+    std::FILE *out = std::fopen(temporary.c_str(), "wb");
+    if (!out) {
+        std::cerr << "obfuscxx_table: cannot write " << temporary << '\n';
+        return 1;
+    }
+
+    // Streams the input a few thousand elements at a time, so table size is not bounded by memory
+    bool ok;
+    std::size_t total = 0, trailing = 0;
+    {
+        detail::table_writer writer(out, element_size, level, seed, nonce, sign_extend);
+        std::vector<unsigned char> chunk(static_cast<std::size_t>(element_size) * 4096);
+
+        ok = true;
+        for (std::size_t read; ok && (read = std::fread(chunk.data(), 1, chunk.size(), in.get())) > 0;) {
+            // fread only returns short at the end of the input
+            trailing = read % element_size;
+            ok = writer.write(chunk.data(), read / element_size);
+            total += read / element_size;
+        }
+        ok = ok && !std::ferror(in.get()) && writer.finish();
+    }
+    ok = (std::fclose(out) == 0) && ok;
+
+    if (!ok) {
+        std::remove(temporary.c_str());
+        std::cerr << "obfuscxx_table: failed to write " << output << '\n';
+        return 1;
+    }
+    if (!detail::replace_file(temporary.c_str(), output.c_str())) {
+        std::cerr << "obfuscxx_table: cannot replace " << output << '\n';
+        return 1;
+    }
+    if (trailing) {
+        std::cerr << "obfuscxx_table: ignored " << trailing << " trailing bytes of " << input << '\n';
+    }
+
+    std::cout << total << " elements of " << element_size << " bytes written to " << output << '\n';
+    return 0;
+}